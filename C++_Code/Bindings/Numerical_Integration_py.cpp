@@ -1,9 +1,18 @@
 #include "../Includes/Integration/Numerical_Integration.hpp"
+#include "../Includes/Integration/Multi_Integration.hpp"
+#include "../Includes/Integration/Monte_Carlo.hpp"
+#include "../Includes/Integration/Sampled_Integration.hpp"
+#include "../Includes/Integration/Expression.hpp"
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h> // we work with function wrappers to keep things as general as possible
+#include <pybind11/numpy.h> // for vectorized integrands
 #include <string> // for to_string, useful for documentation.
+#include <cstdint> // for uintptr_t, the type of the addresses of native functions
+#include <chrono> // for the timeouts of Integral_Future
+#include <memory> // for unique_ptr
+#include "../Includes/Integration/Functions.hpp" // exposed as real_functions and complex_functions
 
 
 
@@ -26,17 +35,415 @@ public:
         compute_integral()
     );
   }
+
+  virtual Integration_Result<T> compute_with_error() override {
+    PYBIND11_OVERRIDE(
+        Integration_Result<T>,
+        Integration<T>,
+        compute_with_error
+    );
+  }
 };
 
 
 
 namespace py = pybind11;
 
+
+
+/* Python objects used by C++ threads (e.g. the Python function wrapped in a C++ integrand) are kept in a shared
+pointer whose deleter takes the GIL, so that they can be copied and destroyed by threads which do not hold it. */
+
+template<typename Object>
+std::shared_ptr<Object> shared_python_object(const Object &object) {
+  return std::shared_ptr<Object>(new Object(object), [](Object* pointer){
+    py::gil_scoped_acquire gil;
+    delete pointer;
+  });
+}
+
+
+
+/* True if the integrand is native, i.e. it can be called without the GIL: either a Native_Function, an Expression
+(which is always used as batch integrand) or a C++ function exposed by this module (e.g. real_functions.sine),
+which pybind11 unwraps into a plain function pointer instead of calling it through the interpreter. */
+
+template<typename Integrator>
+bool integrand_is_native(const Integrator &integrator) {
+  using T = typename std::remove_reference_t<decltype(integrator.integrand)>::result_type;
+  if (integrator.batch_integrand) {return integrator.batch_integrand.template target<Expression>() != nullptr;}
+  return integrator.integrand.template target<Native_Function>() != nullptr || integrator.integrand.template target<T(*)(double)>() != nullptr;
+}
+
+
+
+/* When the integration runs on more than one thread, the integrand is called by the threads of the pool, which
+have to acquire the GIL before calling a Python function: hence we release it while waiting for the result
+(otherwise they would wait forever). With a single thread we keep it, avoiding to release and acquire it again at
+each evaluation, unless the integrand is native: in that case the GIL is never needed, and releasing it allows
+other Python threads to run (e.g. to compute other integrals) in the meantime. */
+
+template<typename Integrator>
+auto compute_releasing_gil(Integrator &integrator) {
+  if (resolve_num_threads(integrator.num_threads) == 1 && !integrand_is_native(integrator)) {return integrator.compute_integral();}
+  py::gil_scoped_release release;
+  return integrator.compute_integral();
+}
+
+
+
+// Same for compute_with_error(), which is declared by Integration only.
+
+template<typename T>
+Integration_Result<T> compute_with_error_releasing_gil(Integration<T> &integrator) {
+  if (resolve_num_threads(integrator.num_threads) == 1 && !integrand_is_native(integrator)) {return integrator.compute_with_error();}
+  py::gil_scoped_release release;
+  return integrator.compute_with_error();
+}
+
+
+
+/* compute_cumulative() returns a NumPy array which takes the ownership of the vector computed in C++ (it is freed
+when the array is), so the values are never copied. The GIL is handled as in compute_releasing_gil(). */
+
+template<typename T>
+py::array_t<T> array_from_vector(std::vector<T> &&values) {
+  auto owner = std::make_unique<std::vector<T>>(std::move(values));
+  const py::ssize_t size = static_cast<py::ssize_t>(owner->size());
+  T* data = owner->data();
+  py::capsule free_when_done(owner.release(), [](void* pointer){delete static_cast<std::vector<T>*>(pointer);});
+  return py::array_t<T>({size}, {static_cast<py::ssize_t>(sizeof(T))}, data, free_when_done);
+}
+
+
+template<typename Integrator>
+auto compute_cumulative_releasing_gil(Integrator &integrator) {
+  decltype(integrator.compute_cumulative()) values;
+  if (resolve_num_threads(integrator.num_threads) == 1 && !integrand_is_native(integrator)) {values = integrator.compute_cumulative();}
+  else {
+    py::gil_scoped_release release;
+    values = integrator.compute_cumulative();
+  }
+  return array_from_vector(std::move(values));
+}
+
+
+
+/* compute_integral_async() runs compute_integral() in a thread of the pool and immediately returns an
+Integral_Future, which Python code can poll or wait for while doing something else (e.g. starting other
+integrations). The GIL is released while waiting for the result, and Python integrands take it when they are
+called, so the integrations overlap as much as their integrands allow: fully if they are native.
+The task keeps the Python integrator alive until it is done. The integrator must not be modified in the
+meantime; its attributes (e.g. error_estimate) are updated when the computation ends, as with compute_integral(). */
+
+template<typename T>
+class Integral_Future {
+public:
+  explicit Integral_Future(std::shared_future<T> future) : future(future) {}
+
+  bool done() const {return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;}
+
+  // Waits at most timeout seconds (forever if it is negative) and returns done().
+
+  bool wait(const double &timeout) const {
+    py::gil_scoped_release release;
+    if (timeout < 0) {future.wait(); return true;}
+    return future.wait_for(std::chrono::duration<double>(timeout)) == std::future_status::ready;
+  }
+
+  T result() const {
+    py::gil_scoped_release release;
+    return future.get(); // Rethrows the exception thrown by compute_integral(), if any
+  }
+
+  std::shared_future<T> future;
+};
+
+
+template<typename Integrator>
+auto compute_integral_async(const py::object &self) {
+  using T = decltype(std::declval<Integrator&>().compute_integral());
+
+  Integrator* integrator = self.cast<Integrator*>();
+  std::shared_ptr<py::object> keep_alive = shared_python_object(self);
+
+  // With a single thread the integrations would not overlap, so the pool has (at least) one thread for each core.
+  global_thread_pool().reserve(std::max(1u, std::thread::hardware_concurrency()));
+
+  return Integral_Future<T>(global_thread_pool().submit([integrator, keep_alive](){return integrator->compute_integral();}).share());
+}
+
+
+
+
+/* Python functions cannot write in a C++ array, so vector-valued integrands return a list of values, which is
+copied in the array expected by Vector_Integration. */
+
+template<typename T>
+Vector_Integrand<T> vector_integrand_from_python(std::function<std::vector<T>(double)> integrand, const std::size_t &number_of_outputs) {
+  return [integrand, number_of_outputs](double x, T* out){
+    std::vector<T> values = integrand(x);
+    if (values.size() != number_of_outputs) {throw std::runtime_error("The integrand must return number_of_outputs values.");}
+    std::copy(values.begin(), values.end(), out);
+  };
+}
+
+
+
+
+/* Vectorized integrands. Calling a Python function once for each node is slow, so the constructors also accept
+the keyword argument 'vectorized': if it is True, the integrand is called with a NumPy array containing a block of
+nodes (at most block_size of them) and must return an array with the values in those nodes, e.g.
+lambda x: np.exp(x)*np.sin(x). In this way the Python function is called once for each block instead of once for
+each node.
+The array of the nodes is a read-only view on the C++ memory, which is only valid during the call: it must not be
+stored by the integrand. The values are converted to the field of the integrator if needed. */
+
+
+// Without the flag we use the usual conversion of pybind11, which is also able to unwrap C++ functions.
+
+template<typename T>
+std::function<T(double)> scalar_from_python(const py::function &integrand) {return integrand.cast<std::function<T(double)>>();}
+
+
+template<typename T>
+Batch_Integrand<T> batch_from_numpy(const py::function &integrand) {
+  std::shared_ptr<py::function> function = shared_python_object(integrand);
+  return [function](const double* x, std::size_t n, T* out){
+    py::gil_scoped_acquire gil;
+
+    py::array_t<double> nodes({static_cast<py::ssize_t>(n)}, {static_cast<py::ssize_t>(sizeof(double))}, x, py::none()); // A view, not a copy
+    nodes.attr("setflags")(py::arg("write") = false);
+
+    auto values = py::array_t<T, py::array::c_style | py::array::forcecast>::ensure((*function)(nodes));
+    if (!values || values.ndim() != 1 || static_cast<std::size_t>(values.size()) != n) {throw std::runtime_error("A vectorized integrand must return a one-dimensional array with one value for each node.");}
+
+    std::copy(values.data(), values.data() + n, out);
+  };
+}
+
+
+/* Creates the integrator with the appropriate wrapper of the Python function (see above), or directly with the
+native function if the integrand is a Native_Function or an Expression. An Expression is already evaluated in
+blocks of nodes, so vectorized is ignored for it. */
+
+template<typename Integrator, typename T, typename... Args>
+Integrator* integrator_from_python(const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized, const Args&... args) {
+  if (py::isinstance<Native_Function>(integrand)) {
+    if (vectorized) {throw std::runtime_error("A native function cannot be vectorized.");}
+    return new Integrator(begin, end, subdivision_n, std::function<T(double)>(integrand.cast<Native_Function>()), args...);
+  }
+  if (py::isinstance<Expression>(integrand)) {return new Integrator(begin, end, subdivision_n, Batch_Integrand<T>(integrand.cast<Expression>()), args...);}
+  if (vectorized) {return new Integrator(begin, end, subdivision_n, batch_from_numpy<T>(integrand.cast<py::function>()), args...);}
+  return new Integrator(begin, end, subdivision_n, scalar_from_python<T>(integrand.cast<py::function>()), args...);
+}
+
+
+
+/* Multidimensional integration (see Multi_Integration.hpp). The dimension is a template parameter in C++, so the
+Python function dispatches on the number of extrema. The integrand receives the point as a list of D coordinates
+or, if vectorized is True, a read-only NumPy array with shape (n, D) containing n points. */
+
+
+template<typename T>
+Batch_Integrand<T> points_batch_from_numpy(const py::function &integrand, const std::size_t &dimension) {
+  std::shared_ptr<py::function> function = shared_python_object(integrand);
+  return [function, dimension](const double* x, std::size_t n, T* out){
+    py::gil_scoped_acquire gil;
+
+    const auto rows = static_cast<py::ssize_t>(n);
+    const auto columns = static_cast<py::ssize_t>(dimension);
+    py::array_t<double> points({rows, columns}, {columns*static_cast<py::ssize_t>(sizeof(double)), static_cast<py::ssize_t>(sizeof(double))}, x, py::none());
+    points.attr("setflags")(py::arg("write") = false);
+
+    auto values = py::array_t<T, py::array::c_style | py::array::forcecast>::ensure((*function)(points));
+    if (!values || values.ndim() != 1 || static_cast<std::size_t>(values.size()) != n) {throw std::runtime_error("A vectorized integrand must return a one-dimensional array with one value for each point.");}
+
+    std::copy(values.data(), values.data() + n, out);
+  };
+}
+
+
+template<typename T, std::size_t D>
+Multi_Batch_Integrand<T, D> multi_batch_from_numpy(const py::function &integrand) {
+  Batch_Integrand<T> batch = points_batch_from_numpy<T>(integrand, D);
+  return [batch](const std::array<double, D>* x, std::size_t n, T* out){batch(x->data(), n, out);};
+}
+
+
+template<typename T, std::size_t D>
+T multi_integrate_fixed(const std::vector<double> &begin, const std::vector<double> &end, const unsigned int &subdivision_n, const py::object &integrand, const std::string &rule, const unsigned int &number_of_nodes, const std::string &grid, const unsigned int &level, const unsigned int &num_threads, const bool &vectorized) {
+
+  std::array<double, D> lower, upper;
+  std::copy(begin.begin(), begin.end(), lower.begin());
+  std::copy(end.begin(), end.end(), upper.begin());
+
+  std::unique_ptr<Multi_Integration<T, D>> integrator;
+  if (vectorized) {integrator = std::make_unique<Multi_Integration<T, D>>(lower, upper, subdivision_n, multi_batch_from_numpy<T, D>(integrand.cast<py::function>()), rule, number_of_nodes, grid, level);}
+  else {integrator = std::make_unique<Multi_Integration<T, D>>(lower, upper, subdivision_n, integrand.cast<Multi_Integrand<T, D>>(), rule, number_of_nodes, grid, level);}
+  integrator->num_threads = num_threads;
+
+  if (resolve_num_threads(num_threads) == 1) {return integrator->compute_integral();}
+  py::gil_scoped_release release;
+  return integrator->compute_integral();
+}
+
+
+template<typename T>
+T multi_integrate(const std::vector<double> &begin, const std::vector<double> &end, const unsigned int &subdivision_n, const py::object &integrand, const std::string &rule, const unsigned int &number_of_nodes, const std::string &grid, const unsigned int &level, const unsigned int &num_threads, const bool &vectorized) {
+  if (begin.size() != end.size()) {throw std::runtime_error("begin and end must have the same length.");}
+  switch (begin.size()) {
+    case 1: return multi_integrate_fixed<T, 1>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 2: return multi_integrate_fixed<T, 2>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 3: return multi_integrate_fixed<T, 3>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 4: return multi_integrate_fixed<T, 4>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 5: return multi_integrate_fixed<T, 5>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 6: return multi_integrate_fixed<T, 6>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 7: return multi_integrate_fixed<T, 7>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    case 8: return multi_integrate_fixed<T, 8>(begin, end, subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized);
+    default: throw std::runtime_error("Only dimensions from 1 to 8 are supported.");
+  }
+}
+
+
+
+
+/* Monte Carlo integration (see Monte_Carlo.hpp). As for multi_integrate, the integrand receives a list of D
+coordinates or, if vectorized is True, a NumPy array with shape (n, D). */
+
+template<typename Integrator, typename T>
+Integrator box_integrator_from_python(const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, const py::object &integrand, const std::uint64_t &seed, const unsigned int &replicates, const bool &vectorized) {
+  const std::size_t dimension = begin.size();
+  if (vectorized) {return Integrator(begin, end, samples, points_batch_from_numpy<T>(integrand.cast<py::function>(), dimension), seed, replicates);}
+  auto function = integrand.cast<std::function<T(const std::vector<double>&)>>();
+  return Integrator(begin, end, samples, Box_Integrand<T>([function, dimension](const double* x){return function(std::vector<double>(x, x + dimension));}), seed, replicates);
+}
+
+
+
+
+/* Integration of sampled data (see Sampled_Integration.hpp). The arrays are received through the buffer protocol:
+if they are already contiguous arrays of the right type (float64 for x, float64 or complex128 for y), the
+integrator reads their memory directly, otherwise they are converted once. No Python code is called during the
+sums, so the GIL is released. */
+
+template<typename T>
+T sampled_integrate(const py::array_t<T, py::array::c_style | py::array::forcecast> &y, const py::object &x, const double &dx, const std::string &rule, const unsigned int &num_threads) {
+  if (y.ndim() != 1) {throw std::runtime_error("y must be a one-dimensional array.");}
+  const std::size_t n = static_cast<std::size_t>(y.shape(0));
+
+  py::array_t<double, py::array::c_style | py::array::forcecast> x_array;
+  if (!x.is_none()) {
+    x_array = py::array_t<double, py::array::c_style | py::array::forcecast>::ensure(x);
+    if (!x_array || x_array.ndim() != 1 || x_array.shape(0) != y.shape(0)) {throw std::runtime_error("x must be a one-dimensional array with the same length as y.");}
+  }
+
+  Sampled_Integration<T> integrator = x.is_none() ? Sampled_Integration<T>(dx, y.data(), n, rule) : Sampled_Integration<T>(x_array.data(), y.data(), n, rule);
+  integrator.num_threads = num_threads;
+
+  py::gil_scoped_release release;
+  return integrator.compute_integral();
+}
+
+
+
+
 PYBIND11_MODULE(integration, m) {
 
     m.doc()="This module can be used to integrate real-valued real or complex functions. Integrators for real or complex functions are wrapped separately, so choose which to use depending on the situation. Integrators are labelled by [Valuetype]_[Method], e.g. 'Real_Midpoint'.";
 
 
+    m.def("set_default_num_threads", &set_default_num_threads, py::arg("num_threads"), "Sets the number of threads used by the integrators whose attribute num_threads is 0. It is 1 at the beginning; 0 means that all the available cores are used.");
+    m.def("get_default_num_threads", &get_default_num_threads, "Returns the number of threads used by the integrators whose attribute num_threads is 0 (0 means all the available cores).");
+
+
+
+    // The futures returned by compute_integral_async() (see Integral_Future above).
+
+
+    py::class_<Integral_Future<double>>(m, "Real_Future")
+        .def("done", &Integral_Future<double>::done, "Returns True if the integral has been computed.")
+        .def("wait", &Integral_Future<double>::wait, py::arg("timeout")=-1.0, "Waits until the integral has been computed, at most timeout seconds if timeout is not negative. Returns done().")
+        .def("result", &Integral_Future<double>::result, "Waits until the integral has been computed and returns it (or raises the exception raised by compute_integral()).")
+        .def("__repr__", [](const Integral_Future<double> &future) {return std::string("<Real_Future> instance, ")+(future.done() ? "done." : "running.");});
+
+    py::class_<Integral_Future<std::complex<double>>>(m, "Complex_Future")
+        .def("done", &Integral_Future<std::complex<double>>::done, "Returns True if the integral has been computed.")
+        .def("wait", &Integral_Future<std::complex<double>>::wait, py::arg("timeout")=-1.0, "Waits until the integral has been computed, at most timeout seconds if timeout is not negative. Returns done().")
+        .def("result", &Integral_Future<std::complex<double>>::result, "Waits until the integral has been computed and returns it (or raises the exception raised by compute_integral()).")
+        .def("__repr__", [](const Integral_Future<std::complex<double>> &future) {return std::string("<Complex_Future> instance, ")+(future.done() ? "done." : "running.");});
+
+
+
+    // The results returned by compute_with_error() (see Integration_Result in Numerical_Integration.hpp).
+
+
+    py::class_<Integration_Result<double>>(m, "Real_Integration_Result")
+        .def_readonly("value", &Integration_Result<double>::value, "The integral (the same value returned by compute_integral()).")
+        .def_readonly("error_estimate", &Integration_Result<double>::error_estimate, "The estimated absolute error (inf if the integrator cannot estimate it).")
+        .def_readonly("evaluations", &Integration_Result<double>::evaluations, "The number of evaluations of the integrand (0 if unknown).")
+        .def("__repr__", [](const Integration_Result<double> &result) {return "<Real_Integration_Result> value "+std::to_string(result.value)+", error_estimate "+std::to_string(result.error_estimate)+", evaluations "+std::to_string(result.evaluations)+".";});
+
+    py::class_<Integration_Result<std::complex<double>>>(m, "Complex_Integration_Result")
+        .def_readonly("value", &Integration_Result<std::complex<double>>::value, "The integral (the same value returned by compute_integral()).")
+        .def_readonly("error_estimate", &Integration_Result<std::complex<double>>::error_estimate, "The estimated absolute error (inf if the integrator cannot estimate it).")
+        .def_readonly("evaluations", &Integration_Result<std::complex<double>>::evaluations, "The number of evaluations of the integrand (0 if unknown).")
+        .def("__repr__", [](const Integration_Result<std::complex<double>> &result) {return "<Complex_Integration_Result> value "+nicer_complex(result.value)+", error_estimate "+std::to_string(result.error_estimate)+", evaluations "+std::to_string(result.evaluations)+".";});
+
+
+
+    /* The functions of Functions.hpp. Since they are C++ functions, pybind11 passes them to the integrators as
+    function pointers: they are called without going through the interpreter and without the GIL. */
+
+
+    py::module_ real_functions = m.def_submodule("real_functions", "Real-valued test functions implemented in C++.");
+    py::module_ complex_functions = m.def_submodule("complex_functions", "Complex-valued test functions implemented in C++.");
+
+    real_functions.def("linear_function", &linear_function<double>).def("square", &ssquare<double>).def("cube", &qube<double>).def("x_4", &forthhh<double>)
+        .def("sine", &sinnus<double>).def("exp_times_sine", &exp_times_sinnus<double>).def("cheb_square", &cheb_ssquare<double>);
+    complex_functions.def("linear_function", &linear_function<std::complex<double>>).def("square", &ssquare<std::complex<double>>).def("cube", &qube<std::complex<double>>).def("x_4", &forthhh<std::complex<double>>)
+        .def("sine", &sinnus<std::complex<double>>).def("exp_times_sine", &exp_times_sinnus<std::complex<double>>).def("cheb_square", &cheb_ssquare<std::complex<double>>);
+
+
+
+    // Native integrands (see Native_Function in Numerical_Integration.hpp). They are passed to the constructors as the integrand.
+
+
+    py::class_<Native_Function>(m, "Native_Function")
+
+        .def(py::init([](const std::uintptr_t &address, const std::uintptr_t &user_data){
+            if (address == 0) {throw std::runtime_error("The address of a native function cannot be 0.");}
+            return Native_Function{reinterpret_cast<double (*)(double, void*)>(address), reinterpret_cast<void*>(user_data)};
+        }), py::arg("address"), py::arg("user_data")=0)
+
+        .def("__doc__", [](){return "This class wraps the address of a C function double f(double x, void* user_data) (e.g. obtained through ctypes, cffi or numba.cfunc), together with the pointer user_data passed to it at each call. When it is used as integrand, the integrators call the function directly and compute_integral() releases the GIL.";})
+        .def("__repr__", [](const Native_Function &function) {return "<Native_Function> instance at address "+std::to_string(reinterpret_cast<std::uintptr_t>(function.function))+".";});
+
+
+
+    /* Integrands given as strings (see Expression.hpp). They are passed to the constructors as the integrand. The
+    values are computed by evaluate() instead of __call__: a callable object would be taken by the overloads
+    expecting a std::function, which call it through the interpreter. */
+
+
+    py::class_<Expression>(m, "Expression")
+
+        .def(py::init<const std::string&>(), py::arg("source"))
+
+        .def("evaluate", [](const Expression &expression, const double &x){return expression(x);}, py::arg("x"), "The value in the point x.")
+        .def("evaluate", [](const Expression &expression, const py::array_t<double, py::array::c_style | py::array::forcecast> &x){
+            py::array_t<double> values(x.request().shape);
+            expression(x.data(), static_cast<std::size_t>(x.size()), values.mutable_data());
+            return values;
+        }, py::arg("x"), "The values in the points of the NumPy array x.")
+
+        .def_readonly("source", &Expression::source, "The string the expression was compiled from.")
+        .def_property_readonly("instructions", [](const Expression &expression){return expression.program.size();}, "The number of instructions of the compiled program (constant subexpressions are folded).")
+
+        .def("__doc__", [](){return "This class compiles a string such as 'x^3*sin(x)' (operators + - * / ^ or **, the variable x, the constants pi and e and the functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp, log, log10, sqrt, abs) into a bytecode evaluated in C++. When it is used as integrand, the nodes are evaluated in blocks without calling Python, and compute_integral() releases the GIL.";})
+        .def("__repr__", [](const Expression &expression) {return "<Expression> '"+expression.source+"' compiled into "+std::to_string(expression.program.size())+" instructions.";});
+
+
 
     // Real case:
 
@@ -48,8 +455,11 @@ PYBIND11_MODULE(integration, m) {
         // We begin binding the constructor and the virtual method. 
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init<const double&, const double&, const unsigned int&, Native_Function>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const Expression &integrand){return new PyIntegration<double>(begin, end, subdivision_n, Batch_Integrand<double>(integrand));}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
         
         .def("compute_integral", &Integration<double>::compute_integral, "Pure virtual method used to perform integration.")
+        .def("compute_with_error", [](Integration<double> &integrator){return compute_with_error_releasing_gil(integrator);}, "Computes the integral together with an estimate of its error and the number of evaluations of the integrand (see Integration_Result in Numerical_Integration.hpp). The error estimate is inf if the integrator cannot estimate it.")
 
 
         /* We use 'readonly' for all the attributes which are labelled as const in the C++ implementation. For
@@ -59,9 +469,10 @@ PYBIND11_MODULE(integration, m) {
         .def_readonly("end", &Integration<double>::end, "The right endpoint 'b' of the interval [a,b] on which integration is being performed.")
         .def_readonly("subdivision_n", &Integration<double>::subdivision_n, "The number of points which are used for the subdivision of the interval for composite integration.")
 
-        .def_readwrite("integrand", &Integration<double>::integrand, "The integrand function.")
+        .def_property("integrand", [](const Integration<double> &integrator){return integrator.integrand;}, [](Integration<double> &integrator, const std::function<double(double)> &integrand){integrator.integrand = integrand; integrator.batch_integrand = nullptr;}, "The integrand function. Assigning it also replaces the vectorized integrand or the Expression the integrator may have been built from, which would otherwise be used by compute_integral().")
         .def_readonly("h", &Integration<double>::h, "The stepsize h = (b-a)/n used for composite integration.")
-        .def_readonly("partition", &Integration<double>::partition, "The set of subintervals used for composite integration. On each one of them, the chosen non-composite integration rule will be used.")
+        .def_readwrite("num_threads", &Integration<double>::num_threads, "The number of threads used by compute_integral(). The default value 0 means that the number returned by get_default_num_threads() is used. The result does not depend on the number of threads; if it is larger than 1, the integrand is called concurrently (taking turns on the GIL if it is a Python function).")
+        .def_property_readonly("partition", [](const Integration<double> &integrator){return integrator.partition.materialize();}, "The set of subintervals used for composite integration. On each one of them, the chosen non-composite integration rule will be used. The C++ object does not store it: the list is created each time the attribute is accessed, so avoid it for very large values of subdivision_n.")
 
         .def("__doc__", [](){return "This class serves as abstract base class for all the real integration methods. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Integration<double> &integrator) {return "<Real_Base> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+" .";});
@@ -71,8 +482,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Midpoint<double>, Integration<double>>(m, "Real_Midpoint")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Midpoint<double>, double>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
 
-        .def("compute_integral", &Midpoint<double>::compute_integral, "Function to perform integration of a real function by using the composite midpoit rule.")
+        .def("compute_integral", [](Midpoint<double> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real function by using the composite midpoit rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Midpoint<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Midpoint<double> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite midpoint rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Midpoint<double> &integrator) {return "<Real_Midpoint> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -82,8 +496,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Trapezoidal<double>, Integration<double>>(m, "Real_Trapezoidal")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Trapezoidal<double>, double>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Trapezoidal<double>::compute_integral, "This class performs integration by using the composite trapezoidal rule.")
+        .def("compute_integral", [](Trapezoidal<double> &integrator){return compute_releasing_gil(integrator);}, "This class performs integration by using the composite trapezoidal rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Trapezoidal<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Trapezoidal<double> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite trapezoidal rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Trapezoidal<double> &integrator) {return "<Real_Trapezoidal> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -92,8 +509,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Simpson<double>, Integration<double>>(m, "Real_Simpson")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Simpson<double>, double>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Simpson<double>::compute_integral, "This class performs integration by using the composite Simpson rule.")
+        .def("compute_integral", [](Simpson<double> &integrator){return compute_releasing_gil(integrator);}, "This class performs integration by using the composite Simpson rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Simpson<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Simpson<double> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite Simpson rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Simpson<double> &integrator) {return "<Real_Simpson> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -102,8 +522,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Gaussian<double>, Integration<double>>(m, "Real_Gaussian")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>, const unsigned int&, const std::string&, const double&, const double&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes"), py::arg("family_of_polynomials")="Legendre", py::arg("alpha")=1, py::arg("beta")=1)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const unsigned int& number_of_nodes, const std::string& family_of_polynomials, const double& alpha, const double& beta, const bool &vectorized){return integrator_from_python<Gaussian<double>, double>(begin, end, subdivision_n, integrand, vectorized, number_of_nodes, family_of_polynomials, alpha, beta);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes"), py::arg("family_of_polynomials")="Legendre", py::arg("alpha")=1, py::arg("beta")=1, py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Gaussian<double>::compute_integral, "This class performs integration by using a gaussian quadrature rule.")
+        .def("compute_integral", [](Gaussian<double> &integrator){return compute_releasing_gil(integrator);}, "This class performs integration by using a gaussian quadrature rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Gaussian<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Gaussian<double> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral(). Only available for the Legendre family.")
 
         .def_readonly("family_of_polynomials", &Gaussian<double>::family_of_polynomials, "The family of polynomials against which we integrate and whose zeros will be the nodes used for polynomial interpolation.")
         .def_readonly("number_of_nodes", &Gaussian<double>::number_of_nodes, "Number of nodes to be used in the gaussian quadratue rule.")
@@ -115,6 +538,107 @@ PYBIND11_MODULE(integration, m) {
 
 
 
+    py::class_<Adaptive<double>, Integration<double>>(m, "Real_Adaptive")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_subintervals")=10000)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_subintervals, const bool &vectorized){return integrator_from_python<Adaptive<double>, double>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_subintervals);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_subintervals")=10000, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Adaptive<double> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued function by using adaptive Gauss-Kronrod integration.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Adaptive<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Adaptive<double>::tolerance, "The absolute tolerance: subintervals are bisected until the sum of their error estimates is below it.")
+        .def_readwrite("max_subintervals", &Adaptive<double>::max_subintervals, "The maximum number of subintervals. If it is reached, the integration stops even if the tolerance is not.")
+        .def_readonly("error_estimate", &Adaptive<double>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Adaptive<double>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Adaptive<double>::converged, "True if the last call to compute_integral() reached the tolerance.")
+
+        .def("__doc__", [](){return "This class performs adaptive integration of real-valued functions, bisecting the subintervals with the largest error (estimated through the 15-point Gauss-Kronrod rule and the embedded 7-point Gauss rule). The attributes are begin, end, subdivision_n (number of subintervals we start from), integrand, tolerance, max_subintervals and, after compute_integral(), error_estimate, evaluations and converged.";})
+        .def("__repr__", [](const Adaptive<double> &integrator) {return "<Real_Adaptive> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Romberg<double>, Integration<double>>(m, "Real_Romberg")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_levels")=20)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_levels, const bool &vectorized){return integrator_from_python<Romberg<double>, double>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_levels);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_levels")=20, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Romberg<double> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued function by using Romberg integration.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Romberg<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Romberg<double>::tolerance, "The tolerance on the difference between two consecutive extrapolated values.")
+        .def_readwrite("max_levels", &Romberg<double>::max_levels, "The maximum number of levels, i.e. of halvings of the stepsize (plus one).")
+        .def_readonly("error_estimate", &Romberg<double>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Romberg<double>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Romberg<double>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("levels", &Romberg<double>::levels, "The number of levels used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Romberg integration of real-valued functions: the stepsize of the trapezoidal rule is halved at each level (evaluating the integrand only in the new points) and the results are improved through Richardson extrapolation. The attributes are begin, end, subdivision_n (number of subintervals of the first level), integrand, tolerance, max_levels and, after compute_integral(), error_estimate, evaluations, converged and levels.";})
+        .def("__repr__", [](const Romberg<double> &integrator) {return "<Real_Romberg> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Clenshaw_Curtis<double>, Integration<double>>(m, "Real_Clenshaw_Curtis")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=12)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_level, const bool &vectorized){return integrator_from_python<Clenshaw_Curtis<double>, double>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_level);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=12, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Clenshaw_Curtis<double> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued function by using Clenshaw-Curtis rules of increasing level.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Clenshaw_Curtis<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Clenshaw_Curtis<double>::tolerance, "The tolerance on the difference between the results of two consecutive levels.")
+        .def_readwrite("max_level", &Clenshaw_Curtis<double>::max_level, "The maximum level: the rule of level k has 2^k + 1 nodes on each subinterval.")
+        .def_readonly("error_estimate", &Clenshaw_Curtis<double>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Clenshaw_Curtis<double>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Clenshaw_Curtis<double>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("level", &Clenshaw_Curtis<double>::level, "The last level used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Clenshaw-Curtis integration of real-valued functions: on each subinterval the level of the rule (2^level + 1 Chebyshev points, whose weights are computed through an FFT and cached) is increased until two consecutive results differ by less than the tolerance. The nodes are nested, so each level only evaluates the integrand in the new points. The attributes are begin, end, subdivision_n, integrand, tolerance, max_level and, after compute_integral(), error_estimate, evaluations, converged and level.";})
+        .def("__repr__", [](const Clenshaw_Curtis<double> &integrator) {return "<Real_Clenshaw_Curtis> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Double_Exponential<double>, Integration<double>>(m, "Real_Double_Exponential")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<double(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=8)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_level, const bool &vectorized){return integrator_from_python<Double_Exponential<double>, double>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_level);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=8, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Double_Exponential<double> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued function by using the tanh-sinh (double exponential) rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Double_Exponential<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Double_Exponential<double>::tolerance, "The tolerance on the difference between the results of two consecutive levels.")
+        .def_readwrite("max_level", &Double_Exponential<double>::max_level, "The maximum level: the step of the trapezoidal rule in the variable u is 2^-level.")
+        .def_readonly("error_estimate", &Double_Exponential<double>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Double_Exponential<double>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Double_Exponential<double>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("level", &Double_Exponential<double>::level, "The last level used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs tanh-sinh (double exponential) integration of real-valued functions, which converges exponentially fast also for integrands with singularities at the endpoints (never evaluated). At each level the step is halved and the integrand is only evaluated in the new nodes, until two consecutive results differ by less than the tolerance. The attributes are begin, end, subdivision_n, integrand, tolerance, max_level and, after compute_integral(), error_estimate, evaluations, converged and level.";})
+        .def("__repr__", [](const Double_Exponential<double> &integrator) {return "<Real_Double_Exponential> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Vector_Integration<double>>(m, "Real_Vector_Integration")
+
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const std::size_t &number_of_outputs, std::function<std::vector<double>(double)> integrand, const std::string &rule, const unsigned int &number_of_nodes){
+            return Vector_Integration<double>(begin, end, subdivision_n, number_of_outputs, vector_integrand_from_python(integrand, number_of_outputs), rule, number_of_nodes);
+          }), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("number_of_outputs"), py::arg("integrand"), py::arg("rule")="Simpson", py::arg("number_of_nodes")=5)
+
+        .def("compute_integral", [](const Vector_Integration<double> &integrator){return compute_releasing_gil(integrator);}, "Computes the integrals of the number_of_outputs components of a real-valued vector-valued function, evaluating it only once in each node. It returns a list.")
+
+        .def_readonly("begin", &Vector_Integration<double>::begin, "The left endpoint 'a' of the interval [a,b] on which integration is being performed.")
+        .def_readonly("end", &Vector_Integration<double>::end, "The right endpoint 'b' of the interval [a,b] on which integration is being performed.")
+        .def_readonly("subdivision_n", &Vector_Integration<double>::subdivision_n, "The number of points which are used for the subdivision of the interval for composite integration.")
+        .def_readonly("number_of_outputs", &Vector_Integration<double>::number_of_outputs, "The number of values returned by the integrand.")
+        .def_readwrite("rule", &Vector_Integration<double>::rule, "The integration rule: 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).")
+        .def_readwrite("number_of_nodes", &Vector_Integration<double>::number_of_nodes, "Number of nodes of the Gaussian rule.")
+        .def_readonly("h", &Vector_Integration<double>::h, "The stepsize h = (b-a)/n used for composite integration.")
+        .def_readwrite("num_threads", &Vector_Integration<double>::num_threads, "The number of threads used by compute_integral() (0 means get_default_num_threads()).")
+
+        .def("__doc__", [](){return "This class integrates real-valued vector-valued functions, i.e. functions returning a list of number_of_outputs values, computing all the integrals in one sweep over the nodes. The attributes are begin, end, subdivision_n, number_of_outputs, rule, number_of_nodes, h and num_threads. The method is compute_integral().";})
+        .def("__repr__", [](const Vector_Integration<double> &integrator) {return "<Real_Vector_Integration> instance. Integrating "+std::to_string(integrator.number_of_outputs)+" functions on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"] with the rule "+integrator.rule+".";});
+
+
+
     // Complex case:
 
 
@@ -122,16 +646,20 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Integration<std::complex<double>>, PyIntegration<std::complex<double>>>(m, "Complex_Base")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init<const double&, const double&, const unsigned int&, Native_Function>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const Expression &integrand){return new PyIntegration<std::complex<double>>(begin, end, subdivision_n, Batch_Integrand<std::complex<double>>(integrand));}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
         
         .def("compute_integral", &Integration<std::complex<double>>::compute_integral, "Pure virtual method to perform integration.")
+        .def("compute_with_error", [](Integration<std::complex<double>> &integrator){return compute_with_error_releasing_gil(integrator);}, "Computes the integral together with an estimate of its error and the number of evaluations of the integrand (see Integration_Result in Numerical_Integration.hpp). The error estimate is inf if the integrator cannot estimate it.")
 
         .def_readonly("begin", &Integration<std::complex<double>>::begin, "The left endpoint 'a' of the interval [a,b] on which integration is being performed.")
         .def_readonly("end", &Integration<std::complex<double>>::end, "The right endpoint 'b' of the interval [a,b] on which integration is being performed.")
         .def_readonly("subdivision_n", &Integration<std::complex<double>>::subdivision_n, "The number of points which are used for the subdivision of the interval for composite integration.")
 
-        .def_readwrite("integrand", &Integration<std::complex<double>>::integrand, "The integrand function.")
+        .def_property("integrand", [](const Integration<std::complex<double>> &integrator){return integrator.integrand;}, [](Integration<std::complex<double>> &integrator, const std::function<std::complex<double>(double)> &integrand){integrator.integrand = integrand; integrator.batch_integrand = nullptr;}, "The integrand function. Assigning it also replaces the vectorized integrand or the Expression the integrator may have been built from, which would otherwise be used by compute_integral().")
         .def_readwrite("h", &Integration<std::complex<double>>::h, "The stepsize h = (b-a)/n used for composite integration.")
-        .def_readwrite("partition", &Integration<std::complex<double>>::partition, "The set of subintervals used for composite integration. On each one of them, the chosen non-composite integration rule will be used.")
+        .def_readwrite("num_threads", &Integration<std::complex<double>>::num_threads, "The number of threads used by compute_integral(). The default value 0 means that the number returned by get_default_num_threads() is used. The result does not depend on the number of threads; if it is larger than 1, the integrand is called concurrently (taking turns on the GIL if it is a Python function).")
+        .def_property_readonly("partition", [](const Integration<std::complex<double>> &integrator){return integrator.partition.materialize();}, "The set of subintervals used for composite integration. On each one of them, the chosen non-composite integration rule will be used. The C++ object does not store it: the list is created each time the attribute is accessed, so avoid it for very large values of subdivision_n.")
 
         .def("__doc__", [](){return "This class serves as abstract base class for all the complex integration methods. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Integration<std::complex<double>> &integrator) {return "<Complex_Base> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+" .";});
@@ -140,8 +668,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Midpoint<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Midpoint")
     
         .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Midpoint<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Midpoint<std::complex<double>>::compute_integral, "Function to perform integration of a real-valued complex function by using the composite midpoit rule.")
+        .def("compute_integral", [](Midpoint<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued complex function by using the composite midpoit rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Midpoint<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Midpoint<std::complex<double>> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite midpoint rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Midpoint<std::complex<double>> &integrator) {return "<Complex_Midpoint> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -151,8 +682,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Trapezoidal<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Trapezoidal")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Trapezoidal<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Trapezoidal<std::complex<double>>::compute_integral, "Function to perform integration of a real-valued complex function by using the composite trapezoidal rule.")
+        .def("compute_integral", [](Trapezoidal<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued complex function by using the composite trapezoidal rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Trapezoidal<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Trapezoidal<std::complex<double>> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite trapezoidal rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Midpoint<std::complex<double>> &integrator) {return "<Complex_Trapezoidal> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -161,8 +695,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Simpson<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Simpson")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"))
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const bool &vectorized){return integrator_from_python<Simpson<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Simpson<std::complex<double>>::compute_integral, "Function to perform integration of a real-valued complex function by using the composite Simpson rule.")
+        .def("compute_integral", [](Simpson<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued complex function by using the composite Simpson rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Simpson<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Simpson<std::complex<double>> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral().")
 
         .def("__doc__", [](){return "This class performs integration of real-valued functions using the composite Simpson rule. The attributes are begin (representing the left endpoint of the integration interval), end (right endpoint), subdivision_n (number of points for the subdivision for composite integration), h (stepsize), integrand, partition (the points delimiting subintervals on which simple integration is performed). The method is compute_integral().";})
         .def("__repr__", [](const Simpson<std::complex<double>> &integrator) {return "<Complex_Simpson> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], stepsize "+std::to_string(integrator.h)+".";});
@@ -172,8 +709,11 @@ PYBIND11_MODULE(integration, m) {
     py::class_<Gaussian<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Gaussian")
 
         .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>, const unsigned int&, const std::string&, const double&, const double&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes"), py::arg("family_of_polynomials")="Legendre", py::arg("alpha")=1, py::arg("beta")=1)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const unsigned int& number_of_nodes, const std::string& family_of_polynomials, const double& alpha, const double& beta, const bool &vectorized){return integrator_from_python<Gaussian<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized, number_of_nodes, family_of_polynomials, alpha, beta);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes"), py::arg("family_of_polynomials")="Legendre", py::arg("alpha")=1, py::arg("beta")=1, py::kw_only(), py::arg("vectorized")=false)
         
-        .def("compute_integral", &Gaussian<std::complex<double>>::compute_integral, "Function to perform integration of a real-valued complex function by using a gaussian quadrature rule.")
+        .def("compute_integral", [](Gaussian<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a real-valued complex function by using a gaussian quadrature rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Gaussian<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+        .def("compute_cumulative", [](Gaussian<std::complex<double>> &integrator){return compute_cumulative_releasing_gil(integrator);}, "Returns a NumPy array with the integrals on [begin, partition[i]] for all the points of the partition (the first one is 0, the last one the whole integral), using the same evaluations as compute_integral(). Only available for the Legendre family.")
 
         .def_readonly("family_of_polynomials", &Gaussian<std::complex<double>>::family_of_polynomials, "The family of polynomials against which we integrate and whose zeros will be the nodes used for polynomial interpolation. Default value = 'Legendre'.")
         .def_readonly("number_of_nodes", &Gaussian<std::complex<double>>::number_of_nodes, "Number of nodes to be used in the gaussian quadrature rule.")
@@ -185,6 +725,286 @@ PYBIND11_MODULE(integration, m) {
 
 
 
-    py::register_exception<std::runtime_error>(m, "RuntimeError"); // if the string 'family_of_polynomials' is invalid
+    py::class_<Adaptive<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Adaptive")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_subintervals")=10000)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_subintervals, const bool &vectorized){return integrator_from_python<Adaptive<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_subintervals);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_subintervals")=10000, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Adaptive<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a complex-valued function by using adaptive Gauss-Kronrod integration.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Adaptive<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Adaptive<std::complex<double>>::tolerance, "The absolute tolerance: subintervals are bisected until the sum of their error estimates is below it.")
+        .def_readwrite("max_subintervals", &Adaptive<std::complex<double>>::max_subintervals, "The maximum number of subintervals. If it is reached, the integration stops even if the tolerance is not.")
+        .def_readonly("error_estimate", &Adaptive<std::complex<double>>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Adaptive<std::complex<double>>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Adaptive<std::complex<double>>::converged, "True if the last call to compute_integral() reached the tolerance.")
+
+        .def("__doc__", [](){return "This class performs adaptive integration of complex-valued functions, bisecting the subintervals with the largest error (estimated through the 15-point Gauss-Kronrod rule and the embedded 7-point Gauss rule). The attributes are begin, end, subdivision_n (number of subintervals we start from), integrand, tolerance, max_subintervals and, after compute_integral(), error_estimate, evaluations and converged.";})
+        .def("__repr__", [](const Adaptive<std::complex<double>> &integrator) {return "<Complex_Adaptive> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Romberg<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Romberg")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_levels")=20)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_levels, const bool &vectorized){return integrator_from_python<Romberg<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_levels);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_levels")=20, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Romberg<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a complex-valued function by using Romberg integration.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Romberg<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Romberg<std::complex<double>>::tolerance, "The tolerance on the difference between two consecutive extrapolated values.")
+        .def_readwrite("max_levels", &Romberg<std::complex<double>>::max_levels, "The maximum number of levels, i.e. of halvings of the stepsize (plus one).")
+        .def_readonly("error_estimate", &Romberg<std::complex<double>>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Romberg<std::complex<double>>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Romberg<std::complex<double>>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("levels", &Romberg<std::complex<double>>::levels, "The number of levels used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Romberg integration of complex-valued functions: the stepsize of the trapezoidal rule is halved at each level (evaluating the integrand only in the new points) and the results are improved through Richardson extrapolation. The attributes are begin, end, subdivision_n (number of subintervals of the first level), integrand, tolerance, max_levels and, after compute_integral(), error_estimate, evaluations, converged and levels.";})
+        .def("__repr__", [](const Romberg<std::complex<double>> &integrator) {return "<Complex_Romberg> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Clenshaw_Curtis<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Clenshaw_Curtis")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=12)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_level, const bool &vectorized){return integrator_from_python<Clenshaw_Curtis<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_level);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=12, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Clenshaw_Curtis<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a complex-valued function by using Clenshaw-Curtis rules of increasing level.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Clenshaw_Curtis<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Clenshaw_Curtis<std::complex<double>>::tolerance, "The tolerance on the difference between the results of two consecutive levels.")
+        .def_readwrite("max_level", &Clenshaw_Curtis<std::complex<double>>::max_level, "The maximum level: the rule of level k has 2^k + 1 nodes on each subinterval.")
+        .def_readonly("error_estimate", &Clenshaw_Curtis<std::complex<double>>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Clenshaw_Curtis<std::complex<double>>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Clenshaw_Curtis<std::complex<double>>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("level", &Clenshaw_Curtis<std::complex<double>>::level, "The last level used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Clenshaw-Curtis integration of complex-valued functions: on each subinterval the level of the rule (2^level + 1 Chebyshev points, whose weights are computed through an FFT and cached) is increased until two consecutive results differ by less than the tolerance. The nodes are nested, so each level only evaluates the integrand in the new points. The attributes are begin, end, subdivision_n, integrand, tolerance, max_level and, after compute_integral(), error_estimate, evaluations, converged and level.";})
+        .def("__repr__", [](const Clenshaw_Curtis<std::complex<double>> &integrator) {return "<Complex_Clenshaw_Curtis> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Double_Exponential<std::complex<double>>, Integration<std::complex<double>>>(m, "Complex_Double_Exponential")
+
+        .def(py::init<const double&, const double&, const unsigned int&, std::function<std::complex<double>(double)>, const double&, const unsigned int&>(), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=8)
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const py::object &integrand, const double& tolerance, const unsigned int& max_level, const bool &vectorized){return integrator_from_python<Double_Exponential<std::complex<double>>, std::complex<double>>(begin, end, subdivision_n, integrand, vectorized, tolerance, max_level);}), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("tolerance")=1e-10, py::arg("max_level")=8, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Double_Exponential<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Function to perform integration of a complex-valued function by using the tanh-sinh (double exponential) rule.")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Double_Exponential<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readwrite("tolerance", &Double_Exponential<std::complex<double>>::tolerance, "The tolerance on the difference between the results of two consecutive levels.")
+        .def_readwrite("max_level", &Double_Exponential<std::complex<double>>::max_level, "The maximum level: the step of the trapezoidal rule in the variable u is 2^-level.")
+        .def_readonly("error_estimate", &Double_Exponential<std::complex<double>>::error_estimate, "The estimated error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Double_Exponential<std::complex<double>>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Double_Exponential<std::complex<double>>::converged, "True if the last call to compute_integral() reached the tolerance.")
+        .def_readonly("level", &Double_Exponential<std::complex<double>>::level, "The last level used by the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs tanh-sinh (double exponential) integration of complex-valued functions, which converges exponentially fast also for integrands with singularities at the endpoints (never evaluated). At each level the step is halved and the integrand is only evaluated in the new nodes, until two consecutive results differ by less than the tolerance. The attributes are begin, end, subdivision_n, integrand, tolerance, max_level and, after compute_integral(), error_estimate, evaluations, converged and level.";})
+        .def("__repr__", [](const Double_Exponential<std::complex<double>> &integrator) {return "<Complex_Double_Exponential> instance. Integrating on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"], tolerance "+std::to_string(integrator.tolerance)+".";});
+
+
+
+    py::class_<Vector_Integration<std::complex<double>>>(m, "Complex_Vector_Integration")
+
+        .def(py::init([](const double &begin, const double &end, const unsigned int &subdivision_n, const std::size_t &number_of_outputs, std::function<std::vector<std::complex<double>>(double)> integrand, const std::string &rule, const unsigned int &number_of_nodes){
+            return Vector_Integration<std::complex<double>>(begin, end, subdivision_n, number_of_outputs, vector_integrand_from_python(integrand, number_of_outputs), rule, number_of_nodes);
+          }), py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("number_of_outputs"), py::arg("integrand"), py::arg("rule")="Simpson", py::arg("number_of_nodes")=5)
+
+        .def("compute_integral", [](const Vector_Integration<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Computes the integrals of the number_of_outputs components of a complex-valued vector-valued function, evaluating it only once in each node. It returns a list.")
+
+        .def_readonly("begin", &Vector_Integration<std::complex<double>>::begin, "The left endpoint 'a' of the interval [a,b] on which integration is being performed.")
+        .def_readonly("end", &Vector_Integration<std::complex<double>>::end, "The right endpoint 'b' of the interval [a,b] on which integration is being performed.")
+        .def_readonly("subdivision_n", &Vector_Integration<std::complex<double>>::subdivision_n, "The number of points which are used for the subdivision of the interval for composite integration.")
+        .def_readonly("number_of_outputs", &Vector_Integration<std::complex<double>>::number_of_outputs, "The number of values returned by the integrand.")
+        .def_readwrite("rule", &Vector_Integration<std::complex<double>>::rule, "The integration rule: 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).")
+        .def_readwrite("number_of_nodes", &Vector_Integration<std::complex<double>>::number_of_nodes, "Number of nodes of the Gaussian rule.")
+        .def_readonly("h", &Vector_Integration<std::complex<double>>::h, "The stepsize h = (b-a)/n used for composite integration.")
+        .def_readwrite("num_threads", &Vector_Integration<std::complex<double>>::num_threads, "The number of threads used by compute_integral() (0 means get_default_num_threads()).")
+
+        .def("__doc__", [](){return "This class integrates complex-valued vector-valued functions, i.e. functions returning a list of number_of_outputs values, computing all the integrals in one sweep over the nodes. The attributes are begin, end, subdivision_n, number_of_outputs, rule, number_of_nodes, h and num_threads. The method is compute_integral().";})
+        .def("__repr__", [](const Vector_Integration<std::complex<double>> &integrator) {return "<Complex_Vector_Integration> instance. Integrating "+std::to_string(integrator.number_of_outputs)+" functions on the interval ["+std::to_string(integrator.begin)+", "+std::to_string(integrator.end)+"] with the rule "+integrator.rule+".";});
+
+
+
+    // Integration on many intervals. As for compute_integral(), the GIL is released if more threads are used.
+
+
+    m.def("real_integrate_many", [](const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<double(double)> integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads){
+            if (resolve_num_threads(num_threads) == 1) {return integrate_many<double>(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads);}
+            py::gil_scoped_release release;
+            return integrate_many<double>(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads);
+        }, py::arg("intervals"), py::arg("rule"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes")=5, py::arg("num_threads")=0,
+        "Integrates a real-valued function on each one of the intervals (a list of pairs (a, b)), returning the list of the results. Each interval is divided in subdivision_n subintervals and rule can be 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre with number_of_nodes nodes). The intervals are distributed among num_threads threads (0 means get_default_num_threads()).");
+
+    m.def("real_integrate_many", [](const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, const py::object &integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads, const bool &vectorized){
+            if (py::isinstance<Native_Function>(integrand) && vectorized) {throw std::runtime_error("A native function cannot be vectorized.");}
+            const bool use_batch = vectorized || py::isinstance<Expression>(integrand);
+            auto wrapped_integrand = py::isinstance<Native_Function>(integrand) ? std::function<double(double)>(integrand.cast<Native_Function>()) : use_batch ? std::function<double(double)>() : scalar_from_python<double>(integrand.cast<py::function>());
+            auto batch_integrand = py::isinstance<Expression>(integrand) ? Batch_Integrand<double>(integrand.cast<Expression>()) : vectorized ? batch_from_numpy<double>(integrand.cast<py::function>()) : Batch_Integrand<double>();
+            py::gil_scoped_release release; // The wrappers take the GIL when they call the integrand
+            if (use_batch) {return integrate_many<double>(intervals, rule, subdivision_n, batch_integrand, number_of_nodes, num_threads);}
+            return integrate_many<double>(intervals, rule, subdivision_n, wrapped_integrand, number_of_nodes, num_threads);
+        }, py::arg("intervals"), py::arg("rule"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes")=5, py::arg("num_threads")=0, py::kw_only(), py::arg("vectorized")=false,
+        "As above, but the integrand can also be a Native_Function or an Expression, and if vectorized is True it is called with a NumPy array of nodes and must return the array of its values.");
+
+    m.def("complex_integrate_many", [](const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<std::complex<double>(double)> integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads){
+            if (resolve_num_threads(num_threads) == 1) {return integrate_many<std::complex<double>>(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads);}
+            py::gil_scoped_release release;
+            return integrate_many<std::complex<double>>(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads);
+        }, py::arg("intervals"), py::arg("rule"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes")=5, py::arg("num_threads")=0,
+        "Integrates a complex-valued function on each one of the intervals (a list of pairs (a, b)), returning the list of the results. Each interval is divided in subdivision_n subintervals and rule can be 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre with number_of_nodes nodes). The intervals are distributed among num_threads threads (0 means get_default_num_threads()).");
+
+    m.def("complex_integrate_many", [](const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, const py::object &integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads, const bool &vectorized){
+            if (py::isinstance<Native_Function>(integrand) && vectorized) {throw std::runtime_error("A native function cannot be vectorized.");}
+            const bool use_batch = vectorized || py::isinstance<Expression>(integrand);
+            auto wrapped_integrand = py::isinstance<Native_Function>(integrand) ? std::function<std::complex<double>(double)>(integrand.cast<Native_Function>()) : use_batch ? std::function<std::complex<double>(double)>() : scalar_from_python<std::complex<double>>(integrand.cast<py::function>());
+            auto batch_integrand = py::isinstance<Expression>(integrand) ? Batch_Integrand<std::complex<double>>(integrand.cast<Expression>()) : vectorized ? batch_from_numpy<std::complex<double>>(integrand.cast<py::function>()) : Batch_Integrand<std::complex<double>>();
+            py::gil_scoped_release release; // The wrappers take the GIL when they call the integrand
+            if (use_batch) {return integrate_many<std::complex<double>>(intervals, rule, subdivision_n, batch_integrand, number_of_nodes, num_threads);}
+            return integrate_many<std::complex<double>>(intervals, rule, subdivision_n, wrapped_integrand, number_of_nodes, num_threads);
+        }, py::arg("intervals"), py::arg("rule"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("number_of_nodes")=5, py::arg("num_threads")=0, py::kw_only(), py::arg("vectorized")=false,
+        "As above, but the integrand can also be a Native_Function or an Expression, and if vectorized is True it is called with a NumPy array of nodes and must return the array of its values.");
+
+
+
+    // Monte Carlo integration (see box_integrator_from_python above).
+
+
+    py::class_<Monte_Carlo<double>>(m, "Real_Monte_Carlo")
+
+        .def(py::init([](const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, const py::object &integrand, const std::uint64_t &seed, const unsigned int &replicates, const bool &vectorized){return box_integrator_from_python<Monte_Carlo<double>, double>(begin, end, samples, integrand, seed, replicates, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("samples"), py::arg("integrand"), py::arg("seed")=0, py::arg("replicates")=1, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Monte_Carlo<double> &integrator){return compute_releasing_gil(integrator);}, "Integrates a real-valued function on the box, stopping when standard_error is below target_error (if it is positive).")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Monte_Carlo<double>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readonly("begin", &Monte_Carlo<double>::begin, "The lower extrema of the box.")
+        .def_readonly("end", &Monte_Carlo<double>::end, "The upper extrema of the box.")
+        .def_readonly("dimension", &Monte_Carlo<double>::dimension, "The dimension of the box.")
+        .def_readwrite("samples", &Monte_Carlo<double>::samples, "The (maximum) number of points of each replicate.")
+        .def_readwrite("seed", &Monte_Carlo<double>::seed, "The seed of the random numbers.")
+        .def_readwrite("replicates", &Monte_Carlo<double>::replicates, "The number of independent estimates, whose spread gives the standard error when there are at least two of them.")
+        .def_readwrite("target_error", &Monte_Carlo<double>::target_error, "If positive, the points are added in rounds until the standard error is below it.")
+        .def_readwrite("num_threads", &Monte_Carlo<double>::num_threads, "The number of threads used by compute_integral() (0 means get_default_num_threads()).")
+        .def_readonly("standard_error", &Monte_Carlo<double>::standard_error, "The standard error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Monte_Carlo<double>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Monte_Carlo<double>::converged, "True if the last call to compute_integral() reached target_error (always True if target_error is 0).")
+        .def_readonly("running_samples", &Monte_Carlo<double>::running_samples, "The number of points of each replicate after each round of the last call to compute_integral().")
+        .def_readonly("running_errors", &Monte_Carlo<double>::running_errors, "The standard error after each round of the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Monte Carlo integration of real-valued functions on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]], using pseudo-random points (counter-based, hence reproducible for any number of threads). The attributes are begin, end, samples, integrand, seed, replicates, target_error and, after compute_integral(), standard_error, evaluations, converged, running_samples and running_errors.";})
+        .def("__repr__", [](const Monte_Carlo<double> &integrator) {return "<Real_Monte_Carlo> instance. Integrating on a box of dimension "+std::to_string(integrator.dimension)+" with "+std::to_string(integrator.samples)+" samples.";});
+
+
+
+    py::class_<Quasi_Monte_Carlo<double>, Monte_Carlo<double>>(m, "Real_Quasi_Monte_Carlo")
+
+        .def(py::init([](const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, const py::object &integrand, const std::uint64_t &seed, const unsigned int &replicates, const bool &vectorized){return box_integrator_from_python<Quasi_Monte_Carlo<double>, double>(begin, end, samples, integrand, seed, replicates, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("samples"), py::arg("integrand"), py::arg("seed")=0, py::arg("replicates")=16, py::kw_only(), py::arg("vectorized")=false)
+
+        .def_readonly("primes", &Quasi_Monte_Carlo<double>::primes, "The bases of the Halton sequence, one for each direction.")
+
+        .def("__doc__", [](){return "This class performs quasi-Monte Carlo integration of real-valued functions on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]], using the points of the Halton sequence, shifted randomly modulo 1 in each replicate (at least 2, since their spread gives the standard error). The attributes are begin, end, samples, integrand, seed, replicates, target_error and, after compute_integral(), standard_error, evaluations, converged, running_samples and running_errors.";})
+        .def("__repr__", [](const Quasi_Monte_Carlo<double> &integrator) {return "<Real_Quasi_Monte_Carlo> instance. Integrating on a box of dimension "+std::to_string(integrator.dimension)+" with "+std::to_string(integrator.samples)+" samples.";});
+
+
+
+    py::class_<Monte_Carlo<std::complex<double>>>(m, "Complex_Monte_Carlo")
+
+        .def(py::init([](const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, const py::object &integrand, const std::uint64_t &seed, const unsigned int &replicates, const bool &vectorized){return box_integrator_from_python<Monte_Carlo<std::complex<double>>, std::complex<double>>(begin, end, samples, integrand, seed, replicates, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("samples"), py::arg("integrand"), py::arg("seed")=0, py::arg("replicates")=1, py::kw_only(), py::arg("vectorized")=false)
+
+        .def("compute_integral", [](Monte_Carlo<std::complex<double>> &integrator){return compute_releasing_gil(integrator);}, "Integrates a complex-valued function on the box, stopping when standard_error is below target_error (if it is positive).")
+        .def("compute_integral_async", [](const py::object &self){return compute_integral_async<Monte_Carlo<std::complex<double>>>(self);}, "Starts compute_integral() in a background thread and returns a future, whose method result() waits for the integral and returns it.")
+
+        .def_readonly("begin", &Monte_Carlo<std::complex<double>>::begin, "The lower extrema of the box.")
+        .def_readonly("end", &Monte_Carlo<std::complex<double>>::end, "The upper extrema of the box.")
+        .def_readonly("dimension", &Monte_Carlo<std::complex<double>>::dimension, "The dimension of the box.")
+        .def_readwrite("samples", &Monte_Carlo<std::complex<double>>::samples, "The (maximum) number of points of each replicate.")
+        .def_readwrite("seed", &Monte_Carlo<std::complex<double>>::seed, "The seed of the random numbers.")
+        .def_readwrite("replicates", &Monte_Carlo<std::complex<double>>::replicates, "The number of independent estimates, whose spread gives the standard error when there are at least two of them.")
+        .def_readwrite("target_error", &Monte_Carlo<std::complex<double>>::target_error, "If positive, the points are added in rounds until the standard error is below it.")
+        .def_readwrite("num_threads", &Monte_Carlo<std::complex<double>>::num_threads, "The number of threads used by compute_integral() (0 means get_default_num_threads()).")
+        .def_readonly("standard_error", &Monte_Carlo<std::complex<double>>::standard_error, "The standard error of the last call to compute_integral().")
+        .def_readonly("evaluations", &Monte_Carlo<std::complex<double>>::evaluations, "The number of evaluations of the integrand in the last call to compute_integral().")
+        .def_readonly("converged", &Monte_Carlo<std::complex<double>>::converged, "True if the last call to compute_integral() reached target_error (always True if target_error is 0).")
+        .def_readonly("running_samples", &Monte_Carlo<std::complex<double>>::running_samples, "The number of points of each replicate after each round of the last call to compute_integral().")
+        .def_readonly("running_errors", &Monte_Carlo<std::complex<double>>::running_errors, "The standard error after each round of the last call to compute_integral().")
+
+        .def("__doc__", [](){return "This class performs Monte Carlo integration of complex-valued functions on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]], using pseudo-random points (counter-based, hence reproducible for any number of threads). The attributes are begin, end, samples, integrand, seed, replicates, target_error and, after compute_integral(), standard_error, evaluations, converged, running_samples and running_errors.";})
+        .def("__repr__", [](const Monte_Carlo<std::complex<double>> &integrator) {return "<Complex_Monte_Carlo> instance. Integrating on a box of dimension "+std::to_string(integrator.dimension)+" with "+std::to_string(integrator.samples)+" samples.";});
+
+
+
+    py::class_<Quasi_Monte_Carlo<std::complex<double>>, Monte_Carlo<std::complex<double>>>(m, "Complex_Quasi_Monte_Carlo")
+
+        .def(py::init([](const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, const py::object &integrand, const std::uint64_t &seed, const unsigned int &replicates, const bool &vectorized){return box_integrator_from_python<Quasi_Monte_Carlo<std::complex<double>>, std::complex<double>>(begin, end, samples, integrand, seed, replicates, vectorized);}), py::arg("begin"), py::arg("end"), py::arg("samples"), py::arg("integrand"), py::arg("seed")=0, py::arg("replicates")=16, py::kw_only(), py::arg("vectorized")=false)
+
+        .def_readonly("primes", &Quasi_Monte_Carlo<std::complex<double>>::primes, "The bases of the Halton sequence, one for each direction.")
+
+        .def("__doc__", [](){return "This class performs quasi-Monte Carlo integration of complex-valued functions on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]], using the points of the Halton sequence, shifted randomly modulo 1 in each replicate (at least 2, since their spread gives the standard error). The attributes are begin, end, samples, integrand, seed, replicates, target_error and, after compute_integral(), standard_error, evaluations, converged, running_samples and running_errors.";})
+        .def("__repr__", [](const Quasi_Monte_Carlo<std::complex<double>> &integrator) {return "<Complex_Quasi_Monte_Carlo> instance. Integrating on a box of dimension "+std::to_string(integrator.dimension)+" with "+std::to_string(integrator.samples)+" samples.";});
+
+
+
+    // Multidimensional integration (see multi_integrate above).
+
+
+    m.def("real_multi_integrate", &multi_integrate<double>, py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("rule")="Gaussian", py::arg("number_of_nodes")=5, py::arg("grid")="Tensor", py::arg("level")=3, py::arg("num_threads")=0, py::kw_only(), py::arg("vectorized")=false,
+        "Integrates a real-valued function on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]] (D from 1 to 8). The grid is either 'Tensor' (the tensor product of the composite rule with subdivision_n subintervals along each direction) or 'Smolyak' (the sparse grid of the given level). The integrand receives a list of D coordinates or, if vectorized is True, a NumPy array with shape (n, D) and must return the n values.");
+
+    m.def("complex_multi_integrate", &multi_integrate<std::complex<double>>, py::arg("begin"), py::arg("end"), py::arg("subdivision_n"), py::arg("integrand"), py::arg("rule")="Gaussian", py::arg("number_of_nodes")=5, py::arg("grid")="Tensor", py::arg("level")=3, py::arg("num_threads")=0, py::kw_only(), py::arg("vectorized")=false,
+        "Integrates a complex-valued function on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]] (D from 1 to 8). The grid is either 'Tensor' (the tensor product of the composite rule with subdivision_n subintervals along each direction) or 'Smolyak' (the sparse grid of the given level). The integrand receives a list of D coordinates or, if vectorized is True, a NumPy array with shape (n, D) and must return the n values.");
+
+
+
+    // Integration of sampled data (see sampled_integrate above).
+
+
+    m.def("real_sampled_integrate", &sampled_integrate<double>, py::arg("y"), py::arg("x")=py::none(), py::arg("dx")=1.0, py::arg("rule")="Trapezoidal", py::arg("num_threads")=0,
+        "Integrates real samples y taken in the points x (strictly increasing, not necessarily equally spaced) or, if x is None, in equally spaced points at distance dx (positive). The rule is 'Trapezoidal', 'Simpson' or 'Spline' (the not-a-knot cubic spline). Contiguous float64 arrays are read without being copied.");
+
+    m.def("complex_sampled_integrate", &sampled_integrate<std::complex<double>>, py::arg("y"), py::arg("x")=py::none(), py::arg("dx")=1.0, py::arg("rule")="Trapezoidal", py::arg("num_threads")=0,
+        "Integrates complex samples y taken in the points x (strictly increasing, not necessarily equally spaced) or, if x is None, in equally spaced points at distance dx (positive). The rule is 'Trapezoidal', 'Simpson' or 'Spline' (the not-a-knot cubic spline). Contiguous complex128 arrays (and float64 arrays for x) are read without being copied.");
+
+
+
+    // Convergence studies (see convergence_study in Numerical_Integration.hpp). As above, the GIL is released if more threads are used.
+
+
+    py::class_<Convergence_Study<double>>(m, "Real_Convergence_Study")
+        .def_readonly("subdivisions", &Convergence_Study<double>::subdivisions, "The numbers of subintervals used at each level.")
+        .def_readonly("results", &Convergence_Study<double>::results, "The integrals computed at each level.")
+        .def_readonly("errors", &Convergence_Study<double>::errors, "The absolute errors at each level.")
+        .def_readonly("convergence_order", &Convergence_Study<double>::convergence_order, "The order of convergence estimated by least squares (NaN if less than two levels could be used).")
+        .def_readonly("levels_used", &Convergence_Study<double>::levels_used, "The number of levels used in the fit (the ones whose error is at the level of the rounding errors are discarded).")
+        .def("__repr__", [](const Convergence_Study<double> &study) {return "<Real_Convergence_Study> instance. Estimated order "+std::to_string(study.convergence_order)+" from "+std::to_string(study.levels_used)+" levels.";});
+
+    py::class_<Convergence_Study<std::complex<double>>>(m, "Complex_Convergence_Study")
+        .def_readonly("subdivisions", &Convergence_Study<std::complex<double>>::subdivisions, "The numbers of subintervals used at each level.")
+        .def_readonly("results", &Convergence_Study<std::complex<double>>::results, "The integrals computed at each level.")
+        .def_readonly("errors", &Convergence_Study<std::complex<double>>::errors, "The absolute errors at each level.")
+        .def_readonly("convergence_order", &Convergence_Study<std::complex<double>>::convergence_order, "The order of convergence estimated by least squares (NaN if less than two levels could be used).")
+        .def_readonly("levels_used", &Convergence_Study<std::complex<double>>::levels_used, "The number of levels used in the fit (the ones whose error is at the level of the rounding errors are discarded).")
+        .def("__repr__", [](const Convergence_Study<std::complex<double>> &study) {return "<Complex_Convergence_Study> instance. Estimated order "+std::to_string(study.convergence_order)+" from "+std::to_string(study.levels_used)+" levels.";});
+
+
+    m.def("real_convergence_study", [](const std::string &rule, std::function<double(double)> integrand, const double &exact, const std::vector<unsigned int> &subdivisions, const double &begin, const double &end, const unsigned int &number_of_nodes, const unsigned int &num_threads){
+            if (resolve_num_threads(num_threads) == 1) {return convergence_study<double>(rule, integrand, exact, subdivisions, begin, end, number_of_nodes, num_threads);}
+            py::gil_scoped_release release;
+            return convergence_study<double>(rule, integrand, exact, subdivisions, begin, end, number_of_nodes, num_threads);
+        }, py::arg("rule"), py::arg("integrand"), py::arg("exact"), py::arg("subdivisions"), py::arg("begin")=0, py::arg("end")=1, py::arg("number_of_nodes")=5, py::arg("num_threads")=0,
+        "Integrates a real-valued function on [begin, end] with each one of the given numbers of subintervals (in parallel) and estimates the order of convergence by a least-squares fit of the errors. The rule can be 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre with number_of_nodes nodes). Returns a Real_Convergence_Study.");
+
+    m.def("complex_convergence_study", [](const std::string &rule, std::function<std::complex<double>(double)> integrand, const std::complex<double> &exact, const std::vector<unsigned int> &subdivisions, const double &begin, const double &end, const unsigned int &number_of_nodes, const unsigned int &num_threads){
+            if (resolve_num_threads(num_threads) == 1) {return convergence_study<std::complex<double>>(rule, integrand, exact, subdivisions, begin, end, number_of_nodes, num_threads);}
+            py::gil_scoped_release release;
+            return convergence_study<std::complex<double>>(rule, integrand, exact, subdivisions, begin, end, number_of_nodes, num_threads);
+        }, py::arg("rule"), py::arg("integrand"), py::arg("exact"), py::arg("subdivisions"), py::arg("begin")=0, py::arg("end")=1, py::arg("number_of_nodes")=5, py::arg("num_threads")=0,
+        "Integrates a complex-valued function on [begin, end] with each one of the given numbers of subintervals (in parallel) and estimates the order of convergence by a least-squares fit of the errors. The rule can be 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre with number_of_nodes nodes). Returns a Complex_Convergence_Study.");
+
+    m.def("polynomial_order", &polynomial_order, py::arg("rule"), py::arg("number_of_nodes")=5, py::arg("max_degree")=100,
+        "Returns the largest k such that the non-composite rule integrates exactly on [0, 1] all the powers x^j with j <= k (at most max_degree).");
+
+
+
+    py::register_exception<std::runtime_error>(m, "RuntimeError"); // if the string 'family_of_polynomials' (or 'rule') is invalid
 
 }
\ No newline at end of file
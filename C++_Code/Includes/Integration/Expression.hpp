@@ -0,0 +1,75 @@
+#ifndef Expression_Hpp
+#define Expression_Hpp
+
+#include <vector>
+#include <string>
+#include <complex>
+#include <cstddef>
+
+
+
+/* In this header we define Expression, an integrand given as a string, e.g. Expression("x^3*sin(x)"). It is mainly
+meant for the Python bindings: instead of calling a Python function in each node, the string is parsed once by the
+constructor and the integrators evaluate it in C++, without the GIL.
+
+The grammar is the usual one, with the variable x:
+- numbers (1, 2.5, 1e-3) and the constants pi and e;
+- the operators + - * / and ^ (or **, as in Python), with the usual precedences: ^ is right-associative and binds
+  more tightly than the unary minus, so -x^2 is -(x^2) and 2^3^2 is 2^9;
+- the functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp, log (natural), log10, sqrt, abs;
+- parentheses.
+The constructor throws an exception (with the position of the error) if the string is not valid.
+
+
+The expression is compiled into a register-based bytecode: each instruction reads one or two registers and writes
+one (the register of a subexpression is its depth in the expression, so only a few registers are needed). Constant
+subexpressions are folded during the compilation, and integer powers with constant exponent (x^3) are computed
+through multiplications instead of std::pow.
+
+The program is executed on blocks of up to block_size points at once: each register is an array of block_size
+values and each instruction is a loop over the block, which the compiler can vectorize, so the cost of decoding an
+instruction is paid once per block instead of once per point. Expression can be used directly as a batch integrand
+(see Batch_Integrand in Numerical_Integration.hpp), both real and complex (the values being real), and also as a
+usual integrand. The evaluation does not modify the object, so it can be done by many threads at the same time. */
+
+
+class Expression {
+public:
+  explicit Expression(const std::string &source);
+
+
+  double operator()(double x) const;
+
+  void operator()(const double* x, std::size_t n, double* out) const;
+  void operator()(const double* x, std::size_t n, std::complex<double>* out) const;
+
+
+  enum class Opcode : unsigned char {
+    Variable, Constant, Add, Subtract, Multiply, Divide, Power, Integer_Power, Negate,
+    Sin, Cos, Tan, Asin, Acos, Atan, Sinh, Cosh, Tanh, Exp, Log, Log10, Sqrt, Abs
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    unsigned int target;
+    unsigned int first = 0;
+    unsigned int second = 0;
+    double constant = 0; // The value of Constant
+    int exponent = 0; // The exponent of Integer_Power
+  };
+
+
+  const std::string source;
+  std::vector<Instruction> program;
+  unsigned int registers = 0;
+
+  static constexpr std::size_t block_size = 256;
+
+
+  // Executes the instruction on n points, the register r being the array registers_data + r*stride.
+
+  static void execute(const Instruction &instruction, double* registers_data, const std::size_t &stride, const double* x, const std::size_t &n);
+};
+
+
+#endif
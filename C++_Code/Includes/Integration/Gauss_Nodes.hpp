@@ -0,0 +1,78 @@
+#ifndef Gauss_Nodes_Hpp
+#define Gauss_Nodes_Hpp
+
+#include <vector>
+#include <string>
+#include <memory>
+
+
+
+/* In this header we define the tables of nodes and weights used by the Gaussian quadrature rules.
+
+Computing the nodes of a Gaussian formula means solving an eigenvalue problem, which is by far the most expensive
+part of a Gaussian integration with a cheap integrand. However, the nodes only depend on the family of polynomials,
+on the number of nodes and on the parameters alpha and beta, and not on the interval: the nodes for [a, b] are
+obtained from the ones on a reference interval through an affine map.
+Hence we compute them once on the reference interval [-1, 1] and we store them in a cache shared by the whole
+process, so that a composite rule with many subintervals (or many Gaussian objects with the same parameters)
+only pays for a single computation.
+
+
+On [a, b] the node t is mapped to x = (a+b)/2 + t*(b-a)/2, while the weight gets multiplied by
+((b-a)/2)^scaling_exponent. The exponent depends on the family, since the weight function is mapped as well
+(e.g. it is 1 for Legendre, 0 for Chebyshev of type 1 and alpha+beta+1 for Jacobi). */
+
+
+struct Gauss_Rule {
+  std::vector<double> nodes; // Nodes on the reference interval [-1, 1]
+  std::vector<double> weights; // The corresponding weights
+  double scaling_exponent; // See the comment above
+};
+
+
+
+/* The following function returns the reference rule for the given family of polynomials, computing it only the
+first time it is requested. It is thread-safe, and the returned pointer stays valid even if the cache is cleared.
+An exception is thrown if the family of polynomials is not valid. */
+
+std::shared_ptr<const Gauss_Rule> reference_gauss_rule(const std::string &family_of_polynomials, const unsigned int &number_of_nodes, const double &alpha = 1, const double &beta = 1);
+
+
+
+/* Clenshaw-Curtis rules are stored in the same struct (with scaling_exponent 1, as for Legendre). The rule of
+the given level has the 2^level + 1 nodes cos(j*pi/2^level), j = 0, ..., 2^level, so the nodes of a level are also
+nodes of the next one (the ones with even j). The weights are obtained from a discrete cosine transform of the
+moments of the Chebyshev polynomials, computed through an FFT in O(n log n) operations. The rules are cached like
+the Gaussian ones; an exception is thrown if level is larger than max_clenshaw_curtis_level. */
+
+constexpr unsigned int max_clenshaw_curtis_level = 24;
+
+std::shared_ptr<const Gauss_Rule> reference_clenshaw_curtis_rule(const unsigned int &level);
+
+
+
+/* The tables of the tanh-sinh (double exponential) rule: the substitution t = tanh(pi/2*sinh(u)) maps the real
+line onto (-1, 1), and the trapezoidal rule with step 2^-level in u converges extremely fast, even if the integrand
+is singular at the endpoints. The level contains the nodes u = k*2^-level with |u| <= tanh_sinh_max_u and k odd (all
+the k at level 0, where the node t = 0 of weight pi/2 is not stored), so the nodes of all the levels up to a given
+one are those of the trapezoidal rule with its step. Since t is positive and very close to 1, we store the
+complements 1 - t (computed without cancellation) and the weights of the positive nodes only: the rule is
+symmetric. Also these tables are computed only once for each level and cached. */
+
+struct Tanh_Sinh_Level {
+  std::vector<double> complements; // 1 - t
+  std::vector<double> weights; // The weights on [-1, 1] (without the step 2^-level)
+};
+
+constexpr double tanh_sinh_max_u = 6.0; // Beyond it, 1 - t is smaller than 1e-275
+
+std::shared_ptr<const Tanh_Sinh_Level> tanh_sinh_level(const unsigned int &level);
+
+
+
+// This one is just used to free the memory used by the caches (e.g. after integrating with a huge number of nodes).
+
+void clear_gauss_rule_cache();
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef Gauss_Tables_Hpp
+#define Gauss_Tables_Hpp
+
+
+
+/* Precomputed Gauss-Legendre nodes and weights on the reference interval [-1, 1] for the most common orders
+(from 1 to legendre_table_max_nodes nodes). They were computed in multiple precision arithmetic (Newton's method on
+the Legendre polynomials with 50 significant digits) and rounded to double precision, so they are slightly more
+accurate than the ones obtained solving the eigenvalue problem in double precision.
+
+The rules are stored one after the other, sorted by number of nodes: the rule with n nodes starts at the position
+n*(n-1)/2 of each array. Nodes are sorted in increasing order. */
+
+
+inline constexpr unsigned int legendre_table_max_nodes = 20;
+
+
+inline constexpr unsigned int legendre_table_offset(const unsigned int n) {return n*(n-1)/2;}
+
+
+
+inline constexpr double legendre_table_nodes[] = {
+  0.0, // n = 1
+  -0.57735026918962576451, 0.57735026918962576451, // n = 2
+  -0.77459666924148337704, 0.0, 0.77459666924148337704, // n = 3
+  -0.86113631159405257522, -0.33998104358485626480, 0.33998104358485626480, 0.86113631159405257522, // n = 4
+  -0.90617984593866399280, -0.53846931010568309104, 0.0, 0.53846931010568309104, 0.90617984593866399280, // n = 5
+  -0.93246951420315202781, -0.66120938646626451366, -0.23861918608319690863, 0.23861918608319690863, 0.66120938646626451366, 0.93246951420315202781, // n = 6
+  -0.94910791234275852453, -0.74153118559939443986, -0.40584515137739716691, 0.0, 0.40584515137739716691, 0.74153118559939443986, 0.94910791234275852453, // n = 7
+  -0.96028985649753623168, -0.79666647741362673959, -0.52553240991632898582, -0.18343464249564980494, 0.18343464249564980494, 0.52553240991632898582, 0.79666647741362673959, 0.96028985649753623168, // n = 8
+  -0.96816023950762608984, -0.83603110732663579430, -0.61337143270059039731, -0.32425342340380892904, 0.0, 0.32425342340380892904, 0.61337143270059039731, 0.83603110732663579430, 0.96816023950762608984, // n = 9
+  -0.97390652851717172008, -0.86506336668898451073, -0.67940956829902440623, -0.43339539412924719080, -0.14887433898163121088, 0.14887433898163121088, 0.43339539412924719080, 0.67940956829902440623, 0.86506336668898451073, 0.97390652851717172008, // n = 10
+  -0.97822865814605699280, -0.88706259976809529908, -0.73015200557404932409, -0.51909612920681181593, -0.26954315595234497233, 0.0, 0.26954315595234497233, 0.51909612920681181593, 0.73015200557404932409, 0.88706259976809529908, 0.97822865814605699280, // n = 11
+  -0.98156063424671925069, -0.90411725637047485668, -0.76990267419430468704, -0.58731795428661744730, -0.36783149899818019375, -0.12523340851146891547, 0.12523340851146891547, 0.36783149899818019375, 0.58731795428661744730, 0.76990267419430468704, 0.90411725637047485668, 0.98156063424671925069, // n = 12
+  -0.98418305471858814947, -0.91759839922297796521, -0.80157809073330991279, -0.64234933944034022064, -0.44849275103644685288, -0.23045831595513479407, 0.0, 0.23045831595513479407, 0.44849275103644685288, 0.64234933944034022064, 0.80157809073330991279, 0.91759839922297796521, 0.98418305471858814947, // n = 13
+  -0.98628380869681233884, -0.92843488366357351734, -0.82720131506976499319, -0.68729290481168547015, -0.51524863635815409197, -0.31911236892788976044, -0.10805494870734366207, 0.10805494870734366207, 0.31911236892788976044, 0.51524863635815409197, 0.68729290481168547015, 0.82720131506976499319, 0.92843488366357351734, 0.98628380869681233884, // n = 14
+  -0.98799251802048542849, -0.93727339240070590431, -0.84820658341042721620, -0.72441773136017004742, -0.57097217260853884754, -0.39415134707756336990, -0.20119409399743452230, 0.0, 0.20119409399743452230, 0.39415134707756336990, 0.57097217260853884754, 0.72441773136017004742, 0.84820658341042721620, 0.93727339240070590431, 0.98799251802048542849, // n = 15
+  -0.98940093499164993260, -0.94457502307323257608, -0.86563120238783174388, -0.75540440835500303390, -0.61787624440264374845, -0.45801677765722738634, -0.28160355077925891323, -0.095012509837637440185, 0.095012509837637440185, 0.28160355077925891323, 0.45801677765722738634, 0.61787624440264374845, 0.75540440835500303390, 0.86563120238783174388, 0.94457502307323257608, 0.98940093499164993260, // n = 16
+  -0.99057547531441733568, -0.95067552176876776122, -0.88023915372698590212, -0.78151400389680140693, -0.65767115921669076585, -0.51269053708647696789, -0.35123176345387631530, -0.17848418149584785585, 0.0, 0.17848418149584785585, 0.35123176345387631530, 0.51269053708647696789, 0.65767115921669076585, 0.78151400389680140693, 0.88023915372698590212, 0.95067552176876776122, 0.99057547531441733568, // n = 17
+  -0.99156516842093094673, -0.95582394957139775518, -0.89260246649755573921, -0.80370495897252311568, -0.69168704306035320787, -0.55977083107394753461, -0.41175116146284264604, -0.25188622569150550959, -0.084775013041735301242, 0.084775013041735301242, 0.25188622569150550959, 0.41175116146284264604, 0.55977083107394753461, 0.69168704306035320787, 0.80370495897252311568, 0.89260246649755573921, 0.95582394957139775518, 0.99156516842093094673, // n = 18
+  -0.99240684384358440319, -0.96020815213483003085, -0.90315590361481790164, -0.82271465653714282498, -0.72096617733522937862, -0.60054530466168102347, -0.46457074137596094572, -0.31656409996362983199, -0.16035864564022537587, 0.0, 0.16035864564022537587, 0.31656409996362983199, 0.46457074137596094572, 0.60054530466168102347, 0.72096617733522937862, 0.82271465653714282498, 0.90315590361481790164, 0.96020815213483003085, 0.99240684384358440319, // n = 19
+  -0.99312859918509492479, -0.96397192727791379127, -0.91223442825132590587, -0.83911697182221882339, -0.74633190646015079261, -0.63605368072651502545, -0.51086700195082709800, -0.37370608871541956067, -0.22778585114164507808, -0.076526521133497333755, 0.076526521133497333755, 0.22778585114164507808, 0.37370608871541956067, 0.51086700195082709800, 0.63605368072651502545, 0.74633190646015079261, 0.83911697182221882339, 0.91223442825132590587, 0.96397192727791379127, 0.99312859918509492479, // n = 20
+};
+
+inline constexpr double legendre_table_weights[] = {
+  2, // n = 1
+  1.0000000000000000000, 1.0000000000000000000, // n = 2
+  0.55555555555555555556, 0.88888888888888888889, 0.55555555555555555556, // n = 3
+  0.34785484513745385737, 0.65214515486254614263, 0.65214515486254614263, 0.34785484513745385737, // n = 4
+  0.23692688505618908751, 0.47862867049936646804, 0.56888888888888888889, 0.47862867049936646804, 0.23692688505618908751, // n = 5
+  0.17132449237917034504, 0.36076157304813860757, 0.46791393457269104739, 0.46791393457269104739, 0.36076157304813860757, 0.17132449237917034504, // n = 6
+  0.12948496616886969327, 0.27970539148927666790, 0.38183005050511894495, 0.41795918367346938776, 0.38183005050511894495, 0.27970539148927666790, 0.12948496616886969327, // n = 7
+  0.10122853629037625915, 0.22238103445337447054, 0.31370664587788728734, 0.36268378337836198297, 0.36268378337836198297, 0.31370664587788728734, 0.22238103445337447054, 0.10122853629037625915, // n = 8
+  0.081274388361574411972, 0.18064816069485740406, 0.26061069640293546232, 0.31234707704000284007, 0.33023935500125976316, 0.31234707704000284007, 0.26061069640293546232, 0.18064816069485740406, 0.081274388361574411972, // n = 9
+  0.066671344308688137594, 0.14945134915058059315, 0.21908636251598204400, 0.26926671930999635509, 0.29552422471475287017, 0.29552422471475287017, 0.26926671930999635509, 0.21908636251598204400, 0.14945134915058059315, 0.066671344308688137594, // n = 10
+  0.055668567116173666483, 0.12558036946490462463, 0.18629021092773425143, 0.23319376459199047992, 0.26280454451024666218, 0.27292508677790063071, 0.26280454451024666218, 0.23319376459199047992, 0.18629021092773425143, 0.12558036946490462463, 0.055668567116173666483, // n = 11
+  0.047175336386511827195, 0.10693932599531843096, 0.16007832854334622633, 0.20316742672306592175, 0.23349253653835480876, 0.24914704581340278500, 0.24914704581340278500, 0.23349253653835480876, 0.20316742672306592175, 0.16007832854334622633, 0.10693932599531843096, 0.047175336386511827195, // n = 12
+  0.040484004765315879520, 0.092121499837728447914, 0.13887351021978723846, 0.17814598076194573828, 0.20781604753688850231, 0.22628318026289723841, 0.23255155323087391019, 0.22628318026289723841, 0.20781604753688850231, 0.17814598076194573828, 0.13887351021978723846, 0.092121499837728447914, 0.040484004765315879520, // n = 13
+  0.035119460331751863032, 0.080158087159760209806, 0.12151857068790318469, 0.15720316715819353457, 0.18553839747793781374, 0.20519846372129560397, 0.21526385346315779020, 0.21526385346315779020, 0.20519846372129560397, 0.18553839747793781374, 0.15720316715819353457, 0.12151857068790318469, 0.080158087159760209806, 0.035119460331751863032, // n = 14
+  0.030753241996117268355, 0.070366047488108124709, 0.10715922046717193501, 0.13957067792615431445, 0.16626920581699393355, 0.18616100001556221103, 0.19843148532711157646, 0.20257824192556127288, 0.19843148532711157646, 0.18616100001556221103, 0.16626920581699393355, 0.13957067792615431445, 0.10715922046717193501, 0.070366047488108124709, 0.030753241996117268355, // n = 15
+  0.027152459411754094852, 0.062253523938647892863, 0.095158511682492784810, 0.12462897125553387205, 0.14959598881657673208, 0.16915651939500253819, 0.18260341504492358887, 0.18945061045506849629, 0.18945061045506849629, 0.18260341504492358887, 0.16915651939500253819, 0.14959598881657673208, 0.12462897125553387205, 0.095158511682492784810, 0.062253523938647892863, 0.027152459411754094852, // n = 16
+  0.024148302868547931960, 0.055459529373987201129, 0.085036148317179180884, 0.11188384719340397109, 0.13513636846852547329, 0.15404576107681028808, 0.16800410215645004451, 0.17656270536699264633, 0.17944647035620652546, 0.17656270536699264633, 0.16800410215645004451, 0.15404576107681028808, 0.13513636846852547329, 0.11188384719340397109, 0.085036148317179180884, 0.055459529373987201129, 0.024148302868547931960, // n = 17
+  0.021616013526483310313, 0.049714548894969796453, 0.076425730254889056529, 0.10094204410628716556, 0.12255520671147846018, 0.14064291467065065120, 0.15468467512626524493, 0.16427648374583272299, 0.16914238296314359184, 0.16914238296314359184, 0.16427648374583272299, 0.15468467512626524493, 0.14064291467065065120, 0.12255520671147846018, 0.10094204410628716556, 0.076425730254889056529, 0.049714548894969796453, 0.021616013526483310313, // n = 18
+  0.019461788229726477036, 0.044814226765699600333, 0.069044542737641226581, 0.091490021622449999464, 0.11156664554733399472, 0.12875396253933622768, 0.14260670217360661178, 0.15276604206585966678, 0.15896884339395434765, 0.16105444984878369598, 0.15896884339395434765, 0.15276604206585966678, 0.14260670217360661178, 0.12875396253933622768, 0.11156664554733399472, 0.091490021622449999464, 0.069044542737641226581, 0.044814226765699600333, 0.019461788229726477036, // n = 19
+  0.017614007139152118312, 0.040601429800386941331, 0.062672048334109063570, 0.083276741576704748725, 0.10193011981724043504, 0.11819453196151841731, 0.13168863844917662690, 0.14209610931838205133, 0.14917298647260374679, 0.15275338713072585070, 0.15275338713072585070, 0.14917298647260374679, 0.14209610931838205133, 0.13168863844917662690, 0.11819453196151841731, 0.10193011981724043504, 0.083276741576704748725, 0.062672048334109063570, 0.040601429800386941331, 0.017614007139152118312, // n = 20
+};
+
+
+
+/* The 15-point Gauss-Kronrod rule on [-1, 1] and the 7-point Gauss rule embedded in it, used by the adaptive
+integrator (the values are the ones of QUADPACK, routine qk15). The rules are symmetric, so we only store the
+nodes in [0, 1], in decreasing order: the Gauss nodes are the ones in odd position, and the last node is 0. */
+
+
+inline constexpr unsigned int kronrod_table_half_nodes = 8;
+
+
+inline constexpr double kronrod15_nodes[] = {
+  0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+  0.586087235467691130294144845693013, 0.405845151377397166906606412076961, 0.207784955007898467600689403773245, 0.0
+};
+
+inline constexpr double kronrod15_weights[] = {
+  0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+  0.169004726639267902826583426598550, 0.190350578064785409913256402421014, 0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+
+inline constexpr double gauss7_weights[] = { // Weights of the nodes kronrod15_nodes[1], [3], [5] and [7]
+  0.129484966168869693270611432679082, 0.279705391489276667901467771423780, 0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+
+#endif
@@ -0,0 +1,686 @@
+#ifndef Integration_Kernels_Hpp
+#define Integration_Kernels_Hpp
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <functional>
+#include <complex>
+#include "Gauss_Nodes.hpp"
+#include "Thread_Pool.hpp"
+
+
+
+/* In this header we define the "kernels" of the integration rules, i.e. the loops which actually compute the
+integrals. Unlike the classes in Numerical_Integration.hpp, they are templatized not only on the field but also on
+the type F of the integrand: when F is a lambda (or any function object) the compiler knows exactly which function
+is called and can inline it, vectorizing the loops. The classes in Numerical_Integration.hpp are thin adapters which
+call these kernels with F = std::function.
+
+F can either be a usual function (field f(double x)) or a batch function (void f(const double* x, std::size_t n,
+field* out)), see Numerical_Integration.hpp. The two cases are distinguished at compile time.
+
+
+Every composite rule is described as a sequence of nodes x_j with weights w_j, so that the integral is equal to
+scale*(sum over j of w_j*f(x_j)). The structs called [Rule]_Nodes know how to generate the nodes and the weights
+and the function weighted_sum() performs the sum, evaluating the integrand in blocks of kernel_block_size points
+stored on the stack.
+
+
+The classes Inline_[Rule] are the ones meant to be used by C++ users. They are usually created through the
+functions make_[rule], e.g.
+
+  auto integrator = make_simpson(0, 1, 100, [](double x){return x*x;});
+  double result = integrator.compute_integral();
+
+where the field is deduced from the return type of the lambda (for batch functions, it must be specified as in
+make_simpson<double>(...)). Setting integrator.num_threads before calling compute_integral() makes the integration
+run in parallel (see reduce_weighted_sum() below). */
+
+
+constexpr std::size_t kernel_block_size = 1024;
+
+
+
+// Evaluates f in the n points contained in x, writing the results in out.
+
+template <typename field, typename F>
+inline void evaluate_points(F &f, const double* x, const std::size_t &n, field* out) {
+  if constexpr (std::is_invocable_v<F&, const double*, std::size_t, field*>) {f(x, n, out);}
+  else {for (std::size_t i = 0; i < n; ++i) {out[i] = f(x[i]);}}
+}
+
+
+
+// The field used by the make_[rule] functions: the one given by the user or, if it is not given, the return type of F.
+
+template <typename field, typename F>
+struct deduced_field {using type = field;};
+
+template <typename F>
+struct deduced_field<void, F> {using type = std::decay_t<std::invoke_result_t<F&, double>>;};
+
+template <typename field, typename F>
+using deduced_field_t = typename deduced_field<field, F>::type;
+
+
+
+/* Vector-valued integrands with a fixed number K of outputs can return a std::array<field, K>, which is then used
+as field: the following functions perform the operations needed by the kernels, componentwise for arrays. In this
+way make_simpson(0, 1, 100, [](double x){return std::array<double, 3>{1, x, x*x};}) computes the three integrals
+evaluating the integrand only once in each node (see also Vector_Integration in Numerical_Integration.hpp, for a
+number of outputs known only at runtime). */
+
+
+template <typename field>
+inline void add_weighted(field &sum, const double &w, const field &y) {sum += w*y;}
+
+template <typename field, std::size_t K>
+inline void add_weighted(std::array<field, K> &sum, const double &w, const std::array<field, K> &y) {
+  for (std::size_t k = 0; k < K; ++k) {sum[k] += w*y[k];}
+}
+
+
+template <typename field>
+inline field scaled(const field &value, const double &scale) {return value*scale;}
+
+template <typename field, std::size_t K>
+inline std::array<field, K> scaled(std::array<field, K> value, const double &scale) {
+  for (std::size_t k = 0; k < K; ++k) {value[k] *= scale;}
+  return value;
+}
+
+
+template <typename field>
+inline field added(const field &first, const field &second) {return first + second;}
+
+template <typename field, std::size_t K>
+inline std::array<field, K> added(std::array<field, K> first, const std::array<field, K> &second) {
+  for (std::size_t k = 0; k < K; ++k) {first[k] += second[k];}
+  return first;
+}
+
+
+
+/* The number of points evaluated at once. It is kernel_block_size for real and complex integrands, and smaller for
+large arrays, so that the values stored on the stack never take more than 16KB. */
+
+template <typename field>
+inline constexpr std::size_t points_per_block = std::clamp<std::size_t>(kernel_block_size*sizeof(std::complex<double>)/sizeof(field), 1, kernel_block_size);
+
+
+
+template <typename field, typename Nodes, typename F>
+field weighted_sum(const Nodes &nodes, F &f, const std::size_t &first, const std::size_t &last) {
+
+  constexpr std::size_t block = points_per_block<field>;
+
+  std::array<double, block> x;
+  std::array<double, block> w;
+  std::array<field, block> y;
+
+  field sum{};
+
+  for (std::size_t j = first; j < last; j += block) {
+
+    const std::size_t count = std::min(block, last - j);
+
+    nodes.fill(j, count, x.data(), w.data());
+    evaluate_points<field>(f, x.data(), count, y.data());
+
+    for (std::size_t k = 0; k < count; ++k) {add_weighted(sum, w[k], y[k]);}
+  }
+
+  return sum;
+}
+
+
+
+/* In order to run in parallel, the nodes are split in chunks of kernel_chunk_size consecutive nodes, the sum on
+each chunk is computed by weighted_sum() in one of the threads and the partial sums are then added pairwise
+(first the chunks 2k and 2k+1, then the results two by two and so on).
+The chunks and the order of the additions only depend on the number of nodes, never on the number of threads:
+hence the result is bitwise identical whatever the number of threads is (including 1, since we follow the same
+steps when running serially). As a bonus, the pairwise sum of the chunks accumulates less rounding error than a
+single running sum over all the nodes.
+
+When num_threads is not 1 the integrand is called concurrently by different threads, so it must be thread-safe
+(e.g. a lambda modifying a captured counter is not). num_threads equal to 0 means "use the default number of
+threads", see Thread_Pool.hpp. */
+
+
+constexpr std::size_t kernel_chunk_size = 64*kernel_block_size;
+
+
+template <typename field>
+field pairwise_sum(const std::vector<field> &values, const std::size_t &first, const std::size_t &last) {
+  if (first == last) {return field{};}
+  if (last - first == 1) {return values[first];}
+  const std::size_t middle = first + (last - first + 1)/2;
+  return added(pairwise_sum(values, first, middle), pairwise_sum(values, middle, last));
+}
+
+
+template <typename field, typename Nodes, typename F>
+field reduce_weighted_sum(const Nodes &nodes, F &f, const unsigned int &num_threads) {
+
+  const std::size_t count = nodes.count();
+  const std::size_t chunks = (count + kernel_chunk_size - 1)/kernel_chunk_size;
+
+  if (chunks <= 1) {return weighted_sum<field>(nodes, f, 0, count);}
+
+  std::vector<field> partial_sums(chunks);
+
+  global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+    partial_sums[c] = weighted_sum<field>(nodes, f, c*kernel_chunk_size, std::min(count, (c + 1)*kernel_chunk_size));
+  });
+
+  return pairwise_sum(partial_sums, 0, chunks);
+}
+
+
+
+
+/* Embedded sums, used to estimate the error without evaluating the integrand again. Nodes providing the method
+fill_embedded(first, n, x, w, v) give, besides the nodes and the weights of the rule, the weights v of a coarser
+rule using the same nodes (some of them with weight 0). The function returns the two sums {sum of w_j*f(x_j),
+sum of v_j*f(x_j)}: the first one is computed exactly as in reduce_weighted_sum() (same blocks, same chunks and
+same order of the additions), so it is bitwise identical to the result of compute_integral(). */
+
+
+template <typename field, typename Nodes, typename F>
+std::array<field, 2> embedded_weighted_sum(const Nodes &nodes, F &f, const std::size_t &first, const std::size_t &last) {
+
+  constexpr std::size_t block = points_per_block<field>;
+
+  std::array<double, block> x;
+  std::array<double, block> w;
+  std::array<double, block> v;
+  std::array<field, block> y;
+
+  std::array<field, 2> sums{};
+
+  for (std::size_t j = first; j < last; j += block) {
+
+    const std::size_t count = std::min(block, last - j);
+
+    nodes.fill_embedded(j, count, x.data(), w.data(), v.data());
+    evaluate_points<field>(f, x.data(), count, y.data());
+
+    for (std::size_t k = 0; k < count; ++k) {
+      add_weighted(sums[0], w[k], y[k]);
+      add_weighted(sums[1], v[k], y[k]);
+    }
+  }
+
+  return sums;
+}
+
+
+template <typename field, typename Nodes, typename F>
+std::array<field, 2> reduce_embedded_sum(const Nodes &nodes, F &f, const unsigned int &num_threads) {
+
+  const std::size_t count = nodes.count();
+  const std::size_t chunks = (count + kernel_chunk_size - 1)/kernel_chunk_size;
+
+  if (chunks <= 1) {return embedded_weighted_sum<field>(nodes, f, 0, count);}
+
+  std::vector<std::array<field, 2>> partial_sums(chunks);
+
+  global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+    partial_sums[c] = embedded_weighted_sum<field>(nodes, f, c*kernel_chunk_size, std::min(count, (c + 1)*kernel_chunk_size));
+  });
+
+  return pairwise_sum(partial_sums, 0, chunks);
+}
+
+
+
+
+/* Cumulative sums, used by compute_cumulative() (see Numerical_Integration.hpp). Nodes providing stride(),
+local_count() and local_weight(k) also describe the rule one subinterval at a time: the subinterval i uses the
+nodes i*stride(), ..., i*stride() + local_count() - 1 with the weights local_weight(0), ..., so that two adjacent
+subintervals share local_count() - stride() nodes (none or their common endpoint). The function returns the
+subdivision_n + 1 values scale*(sum of the contributions of the subintervals 0, ..., i-1).
+
+The subintervals are split in chunks of about kernel_chunk_size nodes, each one evaluating its own nodes (a shared
+endpoint belongs to the chunk on its right, whose first value is then added to the last subinterval of the chunk
+on its left) and computing the running sum of its subintervals. The totals of the chunks are then added serially
+and each chunk adds the total of the previous ones to its running sums in parallel: as for reduce_weighted_sum(),
+the steps only depend on the number of nodes, so the result does not depend on the number of threads. The last
+value agrees with the one of compute_integral() up to rounding, since the additions are made in another order. */
+
+
+template <typename field, typename Nodes, typename F>
+std::vector<field> reduce_cumulative_sum(const Nodes &nodes, F &f, const unsigned int &num_threads) {
+
+  const std::size_t subintervals = nodes.subdivision_n;
+  const std::size_t stride = nodes.stride();
+  const std::size_t shared = nodes.local_count() - stride; // 0 or 1
+  const std::size_t per_chunk = std::max<std::size_t>(1, kernel_chunk_size/stride);
+  const std::size_t chunks = (subintervals + per_chunk - 1)/per_chunk;
+
+  std::vector<field> cumulative(subintervals + 1); // cumulative[0] is 0
+  std::vector<field> first_values(chunks);
+
+  global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+
+    constexpr std::size_t block = points_per_block<field>;
+
+    const std::size_t first_subinterval = c*per_chunk;
+    const std::size_t last_subinterval = std::min(subintervals, first_subinterval + per_chunk);
+    const std::size_t first = first_subinterval*stride;
+    const std::size_t last = (last_subinterval == subintervals) ? nodes.count() : last_subinterval*stride;
+
+    std::array<double, block> x;
+    std::array<double, block> w;
+    std::vector<field> y(last - first);
+
+    for (std::size_t j = first; j < last; j += block) {
+      const std::size_t count = std::min(block, last - j);
+      nodes.fill(j, count, x.data(), w.data());
+      evaluate_points<field>(f, x.data(), count, y.data() + (j - first));
+    }
+
+    first_values[c] = y[0];
+
+    field running{};
+    for (std::size_t i = first_subinterval; i < last_subinterval; ++i) {
+      const std::size_t local_first = (i - first_subinterval)*stride;
+      const std::size_t local_last = std::min(local_first + nodes.local_count(), y.size()); // The shared endpoint may be in the next chunk
+      for (std::size_t k = local_first; k < local_last; ++k) {add_weighted(running, nodes.local_weight(k - local_first), y[k]);}
+      cumulative[i + 1] = running;
+    }
+  });
+
+  // The totals of the chunks, including the shared endpoints, and their (exclusive) running sums.
+
+  std::vector<field> offsets(chunks);
+  field total{};
+  for (std::size_t c = 0; c < chunks; ++c) {
+    const std::size_t last_subinterval = std::min(subintervals, (c + 1)*per_chunk);
+    if (shared > 0 && c + 1 < chunks) {add_weighted(cumulative[last_subinterval], nodes.local_weight(stride), first_values[c + 1]);}
+    offsets[c] = total;
+    total = added(total, cumulative[last_subinterval]);
+  }
+
+  const double scale = nodes.scale();
+
+  global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+    const std::size_t last_subinterval = std::min(subintervals, (c + 1)*per_chunk);
+    for (std::size_t i = c*per_chunk + 1; i <= last_subinterval; ++i) {cumulative[i] = scaled(added(offsets[c], cumulative[i]), scale);}
+  });
+
+  return cumulative;
+}
+
+
+
+
+/* The kernels for integrands with a number K of outputs known only at runtime. The integrand can either write the K
+values in one point (void f(double x, field* out)) or, as a batch function, the values in n points
+(void f(const double* x, std::size_t n, field* out)), in which case out[k*n + i] is the k-th output in x[i].
+The values are always stored in this way (structure of arrays), so that the sum of each output runs on contiguous
+memory and can be vectorized. The sums are added to the K values pointed by sums; y (K*kernel_block_size values, or
+K*(last-first) if fewer) and point_values (K values) are buffers provided by the caller. */
+
+
+template <typename field, typename F>
+inline void evaluate_vector_points(F &f, const double* x, const std::size_t &n, const std::size_t &K, field* out, field* point_values) {
+  if constexpr (std::is_invocable_v<F&, const double*, std::size_t, field*>) {f(x, n, out);}
+  else {
+    for (std::size_t i = 0; i < n; ++i) {
+      f(x[i], point_values);
+      for (std::size_t k = 0; k < K; ++k) {out[k*n + i] = point_values[k];}
+    }
+  }
+}
+
+
+template <typename field, typename Nodes, typename F>
+void vector_weighted_sum(const Nodes &nodes, F &f, const std::size_t &K, const std::size_t &first, const std::size_t &last, field* sums, field* y, field* point_values) {
+
+  std::array<double, kernel_block_size> x;
+  std::array<double, kernel_block_size> w;
+
+  for (std::size_t j = first; j < last; j += kernel_block_size) {
+
+    const std::size_t count = std::min(kernel_block_size, last - j);
+
+    nodes.fill(j, count, x.data(), w.data());
+    evaluate_vector_points<field>(f, x.data(), count, K, y, point_values);
+
+    for (std::size_t k = 0; k < K; ++k) {
+      const field* values = y + k*count;
+      field sum{};
+      for (std::size_t i = 0; i < count; ++i) {sum += w[i]*values[i];}
+      sums[k] += sum;
+    }
+  }
+}
+
+
+/* The same chunks as reduce_weighted_sum(), whose sums are added pairwise in the same order for each one of the
+outputs, so the result does not depend on the number of threads. Inside a block, the sum of each output is computed
+on its own and then added to the sum of the chunk, so it can differ from the one of reduce_weighted_sum() in the last
+bits. Each task takes the chunks t, t + tasks, t + 2*tasks, ... and allocates the buffers once for all of them. */
+
+template <typename field, typename Nodes, typename F>
+std::vector<field> reduce_vector_weighted_sum(const Nodes &nodes, F &f, const std::size_t &K, const unsigned int &num_threads) {
+
+  const std::size_t count = nodes.count();
+  const std::size_t chunks = std::max<std::size_t>(1, (count + kernel_chunk_size - 1)/kernel_chunk_size);
+  const unsigned int threads = resolve_num_threads(num_threads);
+  const std::size_t tasks = std::min<std::size_t>(chunks, threads);
+
+  std::vector<field> partial_sums(chunks*K); // The K sums of the chunk c start at c*K
+
+  global_thread_pool().parallel_for(tasks, threads, [&](std::size_t t){
+    std::vector<field> y(K*std::min(kernel_block_size, count));
+    std::vector<field> point_values(K);
+    for (std::size_t c = t; c < chunks; c += tasks) {
+      vector_weighted_sum<field>(nodes, f, K, c*kernel_chunk_size, std::min(count, (c + 1)*kernel_chunk_size), partial_sums.data() + c*K, y.data(), point_values.data());
+    }
+  });
+
+  std::vector<field> result(K);
+  std::vector<field> output_sums(chunks);
+
+  for (std::size_t k = 0; k < K; ++k) {
+    for (std::size_t c = 0; c < chunks; ++c) {output_sums[c] = partial_sums[c*K + k];}
+    result[k] = pairwise_sum(output_sums, 0, chunks);
+  }
+
+  return result;
+}
+
+
+
+/* The nodes of the composite rules. The partition points are begin + i*h (and the last one is exactly end).
+The trapezoidal and the Simpson rules evaluate the integrand only once in the points shared by two adjacent
+subintervals, giving them the sum of the two weights: hence the trapezoidal rule uses n+1 points instead of 2n,
+while the Simpson rule uses the 2n+1 points begin + j*h/2 instead of 3n. */
+
+
+struct Midpoint_Nodes {
+
+  double begin, end, h;
+  std::size_t subdivision_n;
+
+  std::size_t count() const {return subdivision_n;}
+  double scale() const {return h;}
+
+  void fill(const std::size_t &first, const std::size_t &n, double* x, double* w) const {
+    for (std::size_t k = 0; k < n; ++k) {
+      x[k] = begin + (static_cast<double>(first + k) + 0.5)*h;
+      w[k] = 1.0;
+    }
+  }
+
+  // One node per subinterval (see reduce_cumulative_sum()).
+
+  std::size_t stride() const {return 1;}
+  std::size_t local_count() const {return 1;}
+  double local_weight(const std::size_t &) const {return 1.0;}
+
+  // The embedded rule is the midpoint rule on groups of three subintervals (the last ones are kept as they are).
+
+  void fill_embedded(const std::size_t &first, const std::size_t &n, double* x, double* w, double* v) const {
+    fill(first, n, x, w);
+    const std::size_t grouped = subdivision_n - subdivision_n % 3;
+    for (std::size_t k = 0; k < n; ++k) {
+      const std::size_t j = first + k;
+      v[k] = (j >= grouped) ? 1.0 : ((j % 3 == 1) ? 3.0 : 0.0);
+    }
+  }
+};
+
+
+
+// Weights 1/2, 1, ..., 1, 1/2 (times h).
+
+struct Trapezoidal_Nodes {
+
+  double begin, end, h;
+  std::size_t subdivision_n;
+
+  std::size_t count() const {return subdivision_n + 1;}
+  double scale() const {return h;}
+
+  void fill(const std::size_t &first, const std::size_t &n, double* x, double* w) const {
+    for (std::size_t k = 0; k < n; ++k) {
+      const std::size_t j = first + k;
+      x[k] = begin + static_cast<double>(j)*h;
+      w[k] = (j == 0 || j == subdivision_n) ? 0.5 : 1.0;
+    }
+    if (first + n == count()) {x[n-1] = end;}
+  }
+
+  // The subinterval i uses the points i and i+1 with weights 1/2 (see reduce_cumulative_sum()).
+
+  std::size_t stride() const {return 1;}
+  std::size_t local_count() const {return 2;}
+  double local_weight(const std::size_t &) const {return 0.5;}
+
+  // The embedded rule is the trapezoidal rule on pairs of subintervals (the last one is kept if subdivision_n is odd).
+
+  void fill_embedded(const std::size_t &first, const std::size_t &n, double* x, double* w, double* v) const {
+    fill(first, n, x, w);
+    const std::size_t paired = subdivision_n - subdivision_n % 2;
+    for (std::size_t k = 0; k < n; ++k) {
+      const std::size_t j = first + k;
+      v[k] = 0.0;
+      if (j <= paired && paired > 0 && j % 2 == 0) {v[k] = (j == 0 || j == paired) ? 1.0 : 2.0;}
+      if (paired != subdivision_n && j + 1 >= subdivision_n) {v[k] += 0.5;}
+    }
+  }
+};
+
+
+
+// Weights 1/6, 2/3, 1/3, 2/3, ..., 1/3, 2/3, 1/6 (times h).
+
+struct Simpson_Nodes {
+
+  double begin, end, h;
+  std::size_t subdivision_n;
+
+  std::size_t count() const {return 2*subdivision_n + 1;}
+  double scale() const {return h;}
+
+  void fill(const std::size_t &first, const std::size_t &n, double* x, double* w) const {
+    const double half_h = h/2;
+    for (std::size_t k = 0; k < n; ++k) {
+      const std::size_t j = first + k;
+      x[k] = begin + static_cast<double>(j)*half_h;
+      w[k] = (j == 0 || j == 2*subdivision_n) ? 1.0/6.0 : ((j % 2 == 1) ? 2.0/3.0 : 1.0/3.0);
+    }
+    if (first + n == count()) {x[n-1] = end;}
+  }
+
+  // The subinterval i uses the points 2i, 2i+1, 2i+2 with weights 1/6, 2/3, 1/6 (see reduce_cumulative_sum()).
+
+  std::size_t stride() const {return 2;}
+  std::size_t local_count() const {return 3;}
+  double local_weight(const std::size_t &k) const {return (k == 1) ? 2.0/3.0 : 1.0/6.0;}
+
+  /* The embedded rule is the Simpson rule on pairs of subintervals, whose nodes are the points with j even (the
+  last subinterval is kept if subdivision_n is odd). */
+
+  void fill_embedded(const std::size_t &first, const std::size_t &n, double* x, double* w, double* v) const {
+    fill(first, n, x, w);
+    const std::size_t paired = 2*(subdivision_n - subdivision_n % 2); // The index of the last point of the pairs
+    for (std::size_t k = 0; k < n; ++k) {
+      const std::size_t j = first + k;
+      v[k] = 0.0;
+      if (j <= paired && paired > 0 && j % 2 == 0) {v[k] = (j % 4 == 2) ? 4.0/3.0 : ((j == 0 || j == paired) ? 1.0/3.0 : 2.0/3.0);}
+      if (paired != 2*subdivision_n && j >= paired) {v[k] += (j == paired || j == 2*subdivision_n) ? 1.0/6.0 : 2.0/3.0;}
+    }
+  }
+};
+
+
+
+/* For Gaussian formulas, the reference rule (see Gauss_Nodes.hpp) is mapped on each one of the subintervals.
+Only the Legendre rule is used in its composite version: for the other families, subdivision_n is 1. */
+
+struct Gaussian_Nodes {
+
+  double begin, end, h;
+  std::size_t subdivision_n;
+  std::shared_ptr<const Gauss_Rule> rule;
+
+  std::size_t count() const {return subdivision_n*rule->nodes.size();}
+  double scale() const {return std::pow(h/2, rule->scaling_exponent);}
+
+  void fill(const std::size_t &first, const std::size_t &n, double* x, double* w) const {
+    const std::size_t m = rule->nodes.size();
+    std::size_t i = first/m;
+    std::size_t k = first % m;
+    for (std::size_t c = 0; c < n; ++c) {
+      x[c] = begin + (static_cast<double>(i) + 0.5)*h + (h/2)*rule->nodes[k];
+      w[c] = rule->weights[k];
+      if (++k == m) {k = 0; ++i;}
+    }
+  }
+
+  // Each subinterval has its own m nodes (see reduce_cumulative_sum()).
+
+  std::size_t stride() const {return rule->nodes.size();}
+  std::size_t local_count() const {return rule->nodes.size();}
+  double local_weight(const std::size_t &k) const {return rule->weights[k];}
+};
+
+
+
+// Now the integrators. They store their parameters as the classes in Numerical_Integration.hpp do.
+
+
+template <typename field, typename F>
+class Inline_Midpoint {
+public:
+  Inline_Midpoint(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) : begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), h((end-begin)/subdivision_n) {}
+
+  Midpoint_Nodes nodes() const {return Midpoint_Nodes{begin, end, h, subdivision_n};}
+
+  field compute_integral() {
+    const Midpoint_Nodes n = nodes();
+    return scaled(reduce_weighted_sum<field>(n, integrand, num_threads), n.scale());
+  }
+
+  double begin;
+  double end;
+  unsigned int subdivision_n;
+  F integrand;
+  double h;
+  unsigned int num_threads = 0; // See reduce_weighted_sum()
+};
+
+
+
+template <typename field, typename F>
+class Inline_Trapezoidal {
+public:
+  Inline_Trapezoidal(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) : begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), h((end-begin)/subdivision_n) {}
+
+  Trapezoidal_Nodes nodes() const {return Trapezoidal_Nodes{begin, end, h, subdivision_n};}
+
+  field compute_integral() {
+    const Trapezoidal_Nodes n = nodes();
+    return scaled(reduce_weighted_sum<field>(n, integrand, num_threads), n.scale());
+  }
+
+  double begin;
+  double end;
+  unsigned int subdivision_n;
+  F integrand;
+  double h;
+  unsigned int num_threads = 0; // See reduce_weighted_sum()
+};
+
+
+
+template <typename field, typename F>
+class Inline_Simpson {
+public:
+  Inline_Simpson(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) : begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), h((end-begin)/subdivision_n) {}
+
+  Simpson_Nodes nodes() const {return Simpson_Nodes{begin, end, h, subdivision_n};}
+
+  field compute_integral() {
+    const Simpson_Nodes n = nodes();
+    return scaled(reduce_weighted_sum<field>(n, integrand, num_threads), n.scale());
+  }
+
+  double begin;
+  double end;
+  unsigned int subdivision_n;
+  F integrand;
+  double h;
+  unsigned int num_threads = 0; // See reduce_weighted_sum()
+};
+
+
+
+template <typename field, typename F>
+class Inline_Gaussian {
+public:
+  Inline_Gaussian(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand, const unsigned int &number_of_nodes, const std::string &family_of_polynomials = "Legendre", const double &alpha = 1, const double &beta = 1) :
+  begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), h((end-begin)/subdivision_n), number_of_nodes(number_of_nodes), family_of_polynomials(family_of_polynomials), alpha(alpha), beta(beta),
+  rule(reference_gauss_rule(family_of_polynomials, number_of_nodes, alpha, beta)) {}
+
+  Gaussian_Nodes nodes() const {
+    if (family_of_polynomials == "Legendre") {return Gaussian_Nodes{begin, end, h, subdivision_n, rule};}
+    return Gaussian_Nodes{begin, end, end-begin, 1, rule};
+  }
+
+  field compute_integral() {
+    const Gaussian_Nodes n = nodes();
+    return scaled(reduce_weighted_sum<field>(n, integrand, num_threads), n.scale());
+  }
+
+  double begin;
+  double end;
+  unsigned int subdivision_n;
+  F integrand;
+  double h;
+  unsigned int number_of_nodes;
+  std::string family_of_polynomials;
+  double alpha;
+  double beta;
+  std::shared_ptr<const Gauss_Rule> rule; // Taken from the cache when the object is created
+  unsigned int num_threads = 0; // See reduce_weighted_sum()
+};
+
+
+
+template <typename field = void, typename F>
+Inline_Midpoint<deduced_field_t<field, F>, F> make_midpoint(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) {
+  return Inline_Midpoint<deduced_field_t<field, F>, F>(begin, end, subdivision_n, integrand);
+}
+
+
+template <typename field = void, typename F>
+Inline_Trapezoidal<deduced_field_t<field, F>, F> make_trapezoidal(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) {
+  return Inline_Trapezoidal<deduced_field_t<field, F>, F>(begin, end, subdivision_n, integrand);
+}
+
+
+template <typename field = void, typename F>
+Inline_Simpson<deduced_field_t<field, F>, F> make_simpson(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand) {
+  return Inline_Simpson<deduced_field_t<field, F>, F>(begin, end, subdivision_n, integrand);
+}
+
+
+template <typename field = void, typename F>
+Inline_Gaussian<deduced_field_t<field, F>, F> make_gaussian(const double &begin, const double &end, const unsigned int &subdivision_n, F integrand, const unsigned int &number_of_nodes, const std::string &family_of_polynomials = "Legendre", const double &alpha = 1, const double &beta = 1) {
+  return Inline_Gaussian<deduced_field_t<field, F>, F>(begin, end, subdivision_n, integrand, number_of_nodes, family_of_polynomials, alpha, beta);
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef Monte_Carlo_Hpp
+#define Monte_Carlo_Hpp
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include "Numerical_Integration.hpp"
+
+
+
+/* In this header we define Monte Carlo and quasi-Monte Carlo integration on boxes
+[begin[0], end[0]] x ... x [begin[D-1], end[D-1]], whose dimension D is only known at runtime: unlike the grids of
+Multi_Integration.hpp, the number of points does not grow with D, so they are the methods of choice in high
+dimensions.
+
+The integrand receives a pointer to the D coordinates of a point. The batch integrand has the same type as in one
+dimension (Batch_Integrand, see Numerical_Integration.hpp), but x contains n points of D coordinates each, stored
+one after the other (x[k*D + d] is the coordinate d of the point k).
+
+
+Monte_Carlo uses samples pseudo-random points for each one of the replicates (1 by default). The random numbers
+are counter-based: the coordinate d of the point k of the replicate r is a function (splitmix64) of seed, r and
+k*D + d only, so there is no state shared between the threads, and the points are the same whatever the number of
+threads is. As in one dimension, the points are split in chunks whose statistics (mean and sum of the squared
+deviations) are combined pairwise in a fixed order, so the result does not depend on the number of threads either.
+
+Quasi_Monte_Carlo uses the Halton sequence (the radical inverses of k in the bases given by the first D primes)
+instead, shifted by a random vector modulo 1 (Cranley-Patterson rotation) in each replicate (16 by default). The
+error of the unshifted sequence decreases almost as 1/samples instead of 1/sqrt(samples), but it cannot be
+estimated from the points themselves: the random shifts make each replicate an unbiased estimate, and their spread
+gives the standard error. Hence at least two replicates are needed.
+
+
+The standard error is the one of the sample mean when replicates == 1 and the one of the mean of the replicates
+otherwise. If target_error is positive, the points are added in rounds (each one doubling their number) and the
+integration stops as soon as the standard error is below target_error, or when samples points per replicate have
+been used: in the latter case converged is false. If target_error is 0, all the points are used in a single round
+and converged is true. After compute_integral(), standard_error, evaluations and
+converged describe the last round, while running_samples and running_errors contain the number of points per
+replicate and the standard error after each round. Since the rounds only depend on samples and chunk_size, the
+result is reproducible as well. */
+
+
+template <typename field>
+using Box_Integrand = std::function<field(const double* x)>;
+
+
+
+template <typename field>
+class Monte_Carlo {
+public:
+  Monte_Carlo(const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, Box_Integrand<field> integrand, const std::uint64_t &seed = 0, const unsigned int &replicates = 1) :
+    begin(begin), end(end), dimension(begin.size()), samples(samples), integrand(integrand), seed(seed), replicates(replicates) {}
+
+  Monte_Carlo(const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, Batch_Integrand<field> batch_integrand, const std::uint64_t &seed = 0, const unsigned int &replicates = 1) :
+    begin(begin), end(end), dimension(begin.size()), samples(samples), batch_integrand(batch_integrand), seed(seed), replicates(replicates) {}
+
+
+  field compute_integral(); // Throws an exception if the extrema are not valid, samples is 0 or replicates < minimum_replicates()
+
+
+  virtual ~Monte_Carlo() = default;
+
+
+  const std::vector<double> begin;
+  const std::vector<double> end;
+  const std::size_t dimension;
+  std::size_t samples; // The (maximum) number of points for each replicate
+  Box_Integrand<field> integrand;
+  Batch_Integrand<field> batch_integrand; // Empty unless a batch integrand was given
+  std::uint64_t seed;
+  unsigned int replicates;
+  double target_error = 0; // 0 means that all the samples are used
+  unsigned int num_threads = 0; // See Thread_Pool.hpp
+
+  // The following ones are set by compute_integral().
+
+  double standard_error = 0;
+  std::size_t evaluations = 0;
+  bool converged = false; // True if target_error was reached, or if it is 0
+  std::vector<std::size_t> running_samples;
+  std::vector<double> running_errors;
+
+  static constexpr std::size_t chunk_size = 4*kernel_block_size;
+
+
+protected:
+
+  // Writes in u the n points of the unit cube starting from the point first of the given replicate.
+
+  virtual void unit_points(const unsigned int &replicate, const std::size_t &first, const std::size_t &n, double* u) const;
+
+  // The smallest number of replicates for which the standard error can be computed.
+
+  virtual unsigned int minimum_replicates() const {return 1;}
+};
+
+
+
+template <typename field>
+class Quasi_Monte_Carlo : public Monte_Carlo<field> {
+public:
+  Quasi_Monte_Carlo(const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, Box_Integrand<field> integrand, const std::uint64_t &seed = 0, const unsigned int &replicates = 16) :
+    Monte_Carlo<field>(begin, end, samples, integrand, seed, replicates), primes(first_primes(begin.size())) {}
+
+  Quasi_Monte_Carlo(const std::vector<double> &begin, const std::vector<double> &end, const std::size_t &samples, Batch_Integrand<field> batch_integrand, const std::uint64_t &seed = 0, const unsigned int &replicates = 16) :
+    Monte_Carlo<field>(begin, end, samples, batch_integrand, seed, replicates), primes(first_primes(begin.size())) {}
+
+
+  const std::vector<unsigned int> primes; // The bases of the Halton sequence
+
+
+protected:
+  void unit_points(const unsigned int &replicate, const std::size_t &first, const std::size_t &n, double* u) const override;
+  unsigned int minimum_replicates() const override {return 2;} // The points of one replicate are not independent
+
+private:
+  static std::vector<unsigned int> first_primes(const std::size_t &count);
+};
+
+
+#endif
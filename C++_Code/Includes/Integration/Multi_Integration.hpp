@@ -0,0 +1,81 @@
+#ifndef Multi_Integration_Hpp
+#define Multi_Integration_Hpp
+
+#include <array>
+#include <vector>
+#include <string>
+#include <functional>
+#include <complex>
+#include <cstddef>
+#include "Integration_Kernels.hpp"
+
+
+
+/* In this header we define the integration on D-dimensional boxes [begin_1, end_1] x ... x [begin_D, end_D],
+built on the one-dimensional rules of Integration_Kernels.hpp.
+
+The integrand receives the point as a std::array<double, D>. As in one dimension, it is also possible to give a
+batch integrand, which receives n points (stored one after the other) and writes the n values in out.
+
+
+Two kinds of grids are available, selected through the attribute grid:
+
+- "Tensor": the tensor product of the one-dimensional composite rule (rule = "Midpoint", "Trapezoidal", "Simpson"
+  or "Gaussian", i.e. Gauss-Legendre with number_of_nodes nodes, with subdivision_n subintervals) along each one
+  of the directions. The number of points is m^D, m being the number of nodes of the one-dimensional rule, so it
+  is only feasible in a few dimensions.
+
+- "Smolyak": the sparse grid of the given level, obtained through the combination technique
+      A(level) = sum over the multi-indices i with level+1 <= |i| <= level+D (and i_k >= 1) of
+                 (-1)^(level+D-|i|) * binomial(D-1, level+D-|i|) * U_{i_1} x ... x U_{i_D},
+  where U_i is the i-th one-dimensional rule of the sequence: for the Gaussian rule, the Gauss-Legendre rule with
+  2i-1 nodes on each one of the subdivision_n subintervals, for the other rules the composite rule with
+  subdivision_n*2^(i-1) subintervals (number_of_nodes is not used). For smooth integrands it reaches the accuracy
+  of the tensor grid with far fewer points when D is large. Level 0 is the tensor grid of U_1.
+
+The points of each grid are evaluated in blocks of block_size points, distributed among num_threads threads; as
+in one dimension, the result does not depend on the number of threads. The number of evaluations of the integrand
+performed by the last call to compute_integral() is saved in evaluations.
+
+Only D from 1 to 8 is instantiated in Multi_Integration.cpp. */
+
+
+template <typename field, std::size_t D>
+using Multi_Integrand = std::function<field(const std::array<double, D> &x)>;
+
+template <typename field, std::size_t D>
+using Multi_Batch_Integrand = std::function<void(const std::array<double, D>* x, std::size_t n, field* out)>;
+
+
+
+template <typename field, std::size_t D>
+class Multi_Integration {
+public:
+  Multi_Integration(const std::array<double, D> &begin, const std::array<double, D> &end, const unsigned int &subdivision_n, Multi_Integrand<field, D> integrand, const std::string &rule = "Gaussian", const unsigned int &number_of_nodes = 5, const std::string &grid = "Tensor", const unsigned int &level = 3) :
+    begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), rule(rule), number_of_nodes(number_of_nodes), grid(grid), level(level) {}
+
+  Multi_Integration(const std::array<double, D> &begin, const std::array<double, D> &end, const unsigned int &subdivision_n, Multi_Batch_Integrand<field, D> batch_integrand, const std::string &rule = "Gaussian", const unsigned int &number_of_nodes = 5, const std::string &grid = "Tensor", const unsigned int &level = 3) :
+    begin(begin), end(end), subdivision_n(subdivision_n), batch_integrand(batch_integrand), rule(rule), number_of_nodes(number_of_nodes), grid(grid), level(level) {}
+
+
+  field compute_integral(); // Throws an exception if rule or grid are not valid or subdivision_n is 0
+
+
+  const std::array<double, D> begin;
+  const std::array<double, D> end;
+  const unsigned int subdivision_n;
+  Multi_Integrand<field, D> integrand;
+  Multi_Batch_Integrand<field, D> batch_integrand; // Empty unless a batch integrand was given
+  std::string rule;
+  unsigned int number_of_nodes;
+  std::string grid;
+  unsigned int level; // Only used by Smolyak grids
+  unsigned int num_threads = 0; // See Thread_Pool.hpp
+
+  std::size_t evaluations = 0;
+
+  static constexpr std::size_t block_size = kernel_block_size;
+};
+
+
+#endif
@@ -8,11 +8,14 @@
 #include <cmath>
 #include <complex>
 #include "Functions.hpp"
+#include "Gauss_Nodes.hpp"
+#include "Integration_Kernels.hpp"
 #include <memory> // For shared pointers
 #include <sstream>
 #include <string>
-
-#include <gsl/gsl_integration.h>
+#include <iterator>
+#include <utility>
+#include <limits>
 
 
 
@@ -33,9 +36,14 @@ because we thought that it would be much more easy to use for possible users, si
 secret or needs to be hidden anyway.
 
 
-The abstract class only has one method, which is virtual: it is compute_integral().
-It was not labelled as const for compatibiliy with the library used in the Gaussian integration (GNU GSL).
-More details regarding this aspect are provided in the Gaussian class.
+The abstract class only has one method which must be overridden, compute_integral(). The other virtual method,
+compute_with_error(), also returns an estimate of the error (see Integration_Result below).
+The composite rules (Midpoint, Trapezoidal, Simpson and the Legendre Gaussian) also have compute_cumulative(),
+which returns the integrals on [begin, partition[i]] for all the points of the partition (the first one being 0
+and the last one the whole integral), using the same evaluations as compute_integral() and a parallel prefix sum
+over the subintervals (see reduce_cumulative_sum() in Integration_Kernels.hpp).
+It was not labelled as const for compatibiliy with the library which was originally used in the Gaussian
+integration (GNU GSL), and we kept it this way in order not to break derived classes written by users.
 
 
 We have templatized everything in order to make it possible to perform integration of both real and complex
@@ -43,23 +51,161 @@ valued functions (although always with real argument).
 
 
 For readability reasons, the only things that will be commented in the following are the ones that might not
-be straight-forward. */
+be straight-forward.
+
+
+In addition to the usual integrand, which is evaluated one point at a time, every integrator also accepts a
+"batch" integrand: a function which receives an array x of n points and fills the array out with the n values
+of the function. This allows expensive integrands (e.g. tabulated kernels, or functions using SIMD math) to
+amortize their overhead. All the rules gather their nodes in blocks of at most block_size points and evaluate
+them with a single call (see Integration_Kernels.hpp). The method evaluate() uses the batch integrand if it was
+given and the usual one otherwise.
+
+The loops of the rules are implemented in Integration_Kernels.hpp: C++ users who do not need polymorphism can use
+them directly (e.g. through make_simpson) with a lambda as integrand, which can then be inlined by the compiler. */
+
+
+template <typename field>
+using Batch_Integrand = std::function<void(const double* x, std::size_t n, field* out)>;
+
+
+
+// The following function wraps a batch integrand in order to evaluate it one point at a time.
+
+template <typename field>
+std::function<field(double)> scalar_from_batch(Batch_Integrand<field> batch_integrand) {
+  return [batch_integrand](double x){field y; batch_integrand(&x, 1, &y); return y;};
+}
+
+
+
+/* A plain C function double f(double x, void* user_data), together with the pointer passed to it at each call.
+This is the kind of function produced by ctypes, cffi or Numba's cfunc (and accepted by SciPy's LowLevelCallable):
+the Python bindings wrap its address in this class, so that the integrators call it directly, without going
+through the interpreter. Since it can be stored in a std::function, it can be used as the integrand of any
+integrator (also a complex one, the values being real). */
+
+struct Native_Function {
+  double (*function)(double, void*);
+  void* user_data = nullptr;
+
+  double operator()(double x) const {return function(x, user_data);}
+};
+
+
+
+/* The following class represents the partition of [begin, end] in subdivision_n subintervals used for composite
+integration. The points are not stored: the i-th one is computed on demand as begin + i*h (the last one being
+exactly end). In this way the memory needed does not depend on subdivision_n (a stored partition with 10^9
+subintervals would occupy 8GB) and the rounding errors do not accumulate, as they would if the points were
+obtained by repeatedly adding h.
+It can be used as a (read-only) container, e.g. in range-based for loops, and the method materialize() returns
+all the points in a vector. */
+
+
+class Partition {
+public:
+  Partition(const double &begin, const double &end, const std::size_t &subdivision_n) : left(begin), right(end), subdivision_n(subdivision_n), h((end-begin)/subdivision_n) {}
+
+
+  double operator[](const std::size_t &i) const {return i == subdivision_n ? right : left + static_cast<double>(i)*h;}
+
+  std::size_t size() const {return subdivision_n + 1;}
+
+  std::vector<double> materialize() const {
+    std::vector<double> points(size());
+    for (std::size_t i = 0; i < points.size(); ++i) {points[i] = (*this)[i];}
+    return points;
+  }
+
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = double;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const double*;
+    using reference = double;
+
+    const_iterator(const Partition* partition, const std::size_t &i) : partition(partition), i(i) {}
+
+    double operator*() const {return (*partition)[i];}
+    const_iterator& operator++() {++i; return *this;}
+    const_iterator operator++(int) {const_iterator old = *this; ++i; return old;}
+    bool operator==(const const_iterator &other) const {return i == other.i;}
+    bool operator!=(const const_iterator &other) const {return i != other.i;}
+
+  private:
+    const Partition* partition;
+    std::size_t i;
+  };
+
+  const_iterator begin() const {return const_iterator(this, 0);}
+  const_iterator end() const {return const_iterator(this, size());}
+
+
+  // The names begin and end are already taken by the iterators.
+  const double left;
+  const double right;
+  const std::size_t subdivision_n;
+  const double h;
+};
+
+
+
+/* The result returned by compute_with_error(): the integral, an estimate of its (absolute) error and the number of
+evaluations of the integrand needed to compute both. The Newton-Cotes rules obtain the estimate from the same
+evaluations, comparing the result with the one of a coarser rule whose nodes are a subset of theirs:
+- Midpoint: the midpoint rule on groups of three subintervals (whose midpoints are midpoints of the finer rule),
+  error_estimate = |difference|/8;
+- Trapezoidal: the trapezoidal rule on pairs of subintervals, error_estimate = |difference|/3;
+- Simpson: the Simpson rule on pairs of subintervals, error_estimate = |difference|/15.
+The divisors are the ones given by Richardson extrapolation, since the errors are proportional to h^2, h^2, h^4.
+The Gaussian rule with number_of_nodes nodes is compared with the one (of the same family, on the same
+subintervals) with number_of_nodes-1 nodes, error_estimate = |difference|: it is the error of the coarser rule, so
+for smooth integrands it bounds the error of the finer one, and the evaluations are about twice the ones of
+compute_integral(). If subdivision_n is too small to have a coarser rule (or the Gaussian rule has only one node),
+error_estimate is infinite. The value is exactly the one returned by compute_integral(). Adaptive, Romberg, Clenshaw_Curtis and
+Double_Exponential return their own estimates; the default implementation (e.g. for classes derived by users)
+returns an infinite error_estimate and 0 evaluations, which means "unknown". */
+
+template <typename field>
+struct Integration_Result {
+  field value;
+  double error_estimate;
+  std::size_t evaluations;
+};
+
 
 
 template <typename field> 
 class Integration{
 public:
-  Integration(const double &begin, const double &end, const unsigned int &subdivision_n, std::function<field(double)> integrand) : begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand){
-    partition.push_back(begin);
-    h = (end-begin)/subdivision_n;
-  for (unsigned int i = 1; i < subdivision_n + 1; ++i) {partition.push_back(partition[i-1]+h);}
-  }
+  Integration(const double &begin, const double &end, const unsigned int &subdivision_n, std::function<field(double)> integrand) : begin(begin), end(end), subdivision_n(subdivision_n), integrand(integrand), partition(begin, end, subdivision_n), h(partition.h) {}
+
+  // The partition of the interval is not stored, but computed on demand (see the class Partition above).
+
+
+  /* If a batch integrand is given, the usual integrand is set to a wrapper evaluating it one point at a time, so
+  that the attribute 'integrand' can always be used. */
 
-  // The constructor creates the subintervals on which we perform the integration.
+  Integration(const double &begin, const double &end, const unsigned int &subdivision_n, Batch_Integrand<field> batch_integrand) : Integration(begin, end, subdivision_n, scalar_from_batch(batch_integrand)) {
+    this->batch_integrand = batch_integrand;
+  }
 
 
   virtual field compute_integral() = 0;
 
+  virtual Integration_Result<field> compute_with_error() {return {compute_integral(), std::numeric_limits<double>::infinity(), 0};}
+
+
+  // Evaluates the integrand in the n points contained in x, writing the results in out.
+
+  void evaluate(const double* x, const std::size_t &n, field* out) const {
+    if (batch_integrand) {batch_integrand(x, n, out);}
+    else {for (std::size_t i = 0; i < n; ++i) {out[i] = integrand(x[i]);}}
+  }
+
 
 
   virtual ~Integration() = default; 
@@ -70,8 +216,12 @@ public:
   const double end;
   const unsigned int subdivision_n;
   std::function<field(double)> integrand;
-  std::vector<double> partition; // We save the partition of the interval
+  Batch_Integrand<field> batch_integrand; // Empty unless a batch integrand was given. If it is not, it is used instead of 'integrand' (so clear it when replacing the integrand).
+  Partition partition; // The partition of the interval, computed lazily
   double h; // We also save the stepsize
+  unsigned int num_threads = 0; // Number of threads used by compute_integral(); 0 means the default one, see Thread_Pool.hpp
+
+  static constexpr std::size_t block_size = kernel_block_size; // Maximum number of points passed to the integrand at once (see above)
 };
 
 
@@ -81,9 +231,13 @@ class Midpoint : public Integration<field> {
 public:
   Midpoint(const double &begin, const double &end, const unsigned int &subdivision_n, std::function<field(double)> integrand) :  Integration<field>(begin, end, subdivision_n, integrand) {}
 
+  Midpoint(const double &begin, const double &end, const unsigned int &subdivision_n, Batch_Integrand<field> batch_integrand) :  Integration<field>(begin, end, subdivision_n, batch_integrand) {}
+
 
 
   field compute_integral() override;
+  Integration_Result<field> compute_with_error() override;
+  std::vector<field> compute_cumulative(); // The integral on [begin, partition[i]] for each i, see above
 };
 
 
@@ -93,9 +247,13 @@ class Trapezoidal : public Integration<field> {
 public:
   Trapezoidal(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand) :  Integration<field>(begin, end, subdivision_n, integrand) {}
 
+  Trapezoidal(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand) :  Integration<field>(begin, end, subdivision_n, batch_integrand) {}
+
 
 
   field compute_integral() override;
+  Integration_Result<field> compute_with_error() override;
+  std::vector<field> compute_cumulative(); // The integral on [begin, partition[i]] for each i, see above
 };
 
 
@@ -105,14 +263,18 @@ class Simpson : public Integration<field> {
 public:
   Simpson(const double &begin, const double &end, const unsigned int &subdivision_n, std::function<field(double)> integrand) :  Integration<field>(begin, end, subdivision_n, integrand) {}
 
+  Simpson(const double &begin, const double &end, const unsigned int &subdivision_n, Batch_Integrand<field> batch_integrand) :  Integration<field>(begin, end, subdivision_n, batch_integrand) {}
+
 
 
   field compute_integral() override;
+  Integration_Result<field> compute_with_error() override;
+  std::vector<field> compute_cumulative(); // The integral on [begin, partition[i]] for each i, see above
 };
 
 
 
-/* The following class implements gaussian integration using the GNU GSL.
+/* The following class implements gaussian integration.
 Here some additional objects need to be given as input to the constructor.
 Indeed, in addition to the previous ones, here we also need the number of nodes for the gaussian formula, a string
 representing the family of polynomials chosen and the parameters alpha and beta.
@@ -125,7 +287,10 @@ See https://www.gnu.org/software/gsl/doc/html/integration.html#tab-fixed-quadrat
 for more details regarding the families of polynomials. Here we have implemented the method for the two 
 Chebyshev families, Jacobi, exponential and Gegenbauer. 
 
-All the code was written following the GNU GSL documentation. */
+The code was originally written following the GNU GSL documentation, and the weight functions are still the same
+ones used there. However, the nodes and the weights are now computed by us (see Gauss_Nodes.hpp) and taken from a
+process-wide cache, then mapped on each subinterval, so that the integrand is evaluated directly by our loop,
+without passing through a C callback. */
 
 
 template <typename field>
@@ -133,20 +298,14 @@ class Gaussian : public Integration<field> {
   public:
   Gaussian(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand, const unsigned int &number_of_nodes, const std::string& family_of_polynomials = "Legendre", const double &alpha = 1, const double &beta = 1) :
   Integration<field>(begin, end, subdivision_n, integrand), number_of_nodes(number_of_nodes), family_of_polynomials(family_of_polynomials), alpha(alpha), beta(beta) {} 
-  
-
-  /* The following two methods are needed because we need to pass a static member to the gsl integrator.
-  So we first created a temporary function and then a static method to evaluate the input function.
-  See the corresponding .tpl.hpp file for more details.
-  The function passed to gsl needs to depend on double x and void* params. */
-
-  static field static_tmp_fct(double x, void* params) {return static_cast<Gaussian*>(params)->tmp_function(x);}
-
-
-  field tmp_function(double x) {return this->integrand(x);}
 
+  Gaussian(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand, const unsigned int &number_of_nodes, const std::string& family_of_polynomials = "Legendre", const double &alpha = 1, const double &beta = 1) :
+  Integration<field>(begin, end, subdivision_n, batch_integrand), number_of_nodes(number_of_nodes), family_of_polynomials(family_of_polynomials), alpha(alpha), beta(beta) {} 
+  
 
   field compute_integral() override;
+  Integration_Result<field> compute_with_error() override;
+  std::vector<field> compute_cumulative(); // Throws an exception if the family is not Legendre, since the rule is not composite
 
 
   ~Gaussian() {}
@@ -162,10 +321,275 @@ class Gaussian : public Integration<field> {
 
 
 
-/* To appreciate the following functions, it is suggested to look at the specialization of the integration method
-in the .tpl.hpp file.
-They are just needed in order to properly split and give as input for the integration the real and the imaginary
-part of a function. */
+/* The following class performs adaptive integration: instead of using the same stepsize everywhere, only the
+subintervals where the integrand is hard to integrate are bisected, until the estimated error is below the
+tolerance. On each subinterval we use the 15-point Gauss-Kronrod rule, whose difference with the 7-point Gauss
+rule embedded in it (using 7 of the same 15 points) gives the error estimate.
+
+The subintervals are kept in a priority queue ordered by error estimate, so that at each step the worst one is
+bisected. We start from the subdivision_n subintervals of the partition and we stop when the sum of the errors is
+below the (absolute) tolerance or when there are max_subintervals subintervals: in the latter case converged is
+false and error_estimate tells how accurate the result is. After compute_integral(), error_estimate and evaluations
+contain the estimated error and the number of evaluations of the integrand.
+
+The bisections depend on each other, so this integrator always runs on a single thread. */
+
+
+template <typename field>
+class Adaptive : public Integration<field> {
+  public:
+  Adaptive(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand, const double &tolerance = 1e-10, const unsigned int &max_subintervals = 10000) :
+  Integration<field>(begin, end, subdivision_n, integrand), tolerance(tolerance), max_subintervals(max_subintervals) {}
+
+  Adaptive(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand, const double &tolerance = 1e-10, const unsigned int &max_subintervals = 10000) :
+  Integration<field>(begin, end, subdivision_n, batch_integrand), tolerance(tolerance), max_subintervals(max_subintervals) {}
+
+
+  field compute_integral() override; // Throws an exception if subdivision_n is 0
+  Integration_Result<field> compute_with_error() override;
+
+
+  ~Adaptive() {}
+
+
+  double tolerance;
+  unsigned int max_subintervals;
+
+  // The following ones are set by compute_integral().
+
+  double error_estimate = 0;
+  std::size_t evaluations = 0;
+  bool converged = false;
+};
+
+
+
+/* Romberg integration. We start from the trapezoidal rule T_0 on the subdivision_n subintervals of the partition
+and we halve the stepsize at each level: the points of T_k are also points of T_(k+1), so we only need to evaluate
+the integrand in the new midpoints, since T_(k+1) = (T_k + M_k)/2 where M_k is the midpoint rule with the stepsize
+of T_k. Hence the total number of evaluations is the one of the last level, and not the sum over all the levels.
+
+Then we use Richardson extrapolation: since the error of the trapezoidal rule is a series in even powers of h,
+      R(k,j) = R(k,j-1) + (R(k,j-1) - R(k-1,j-1))/(4^j - 1)
+removes one more term at each step j, and the diagonal R(k,k) converges much faster than T_k for smooth integrands.
+We stop when two consecutive diagonal values differ by less than the tolerance (comparing at least three levels,
+to avoid stopping by chance), or after max_levels levels. As for Adaptive, error_estimate, evaluations and
+converged are set by compute_integral(), together with the number of levels used. */
+
+
+template <typename field>
+class Romberg : public Integration<field> {
+  public:
+  Romberg(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand, const double &tolerance = 1e-10, const unsigned int &max_levels = 20) :
+  Integration<field>(begin, end, subdivision_n, integrand), tolerance(tolerance), max_levels(max_levels) {}
+
+  Romberg(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand, const double &tolerance = 1e-10, const unsigned int &max_levels = 20) :
+  Integration<field>(begin, end, subdivision_n, batch_integrand), tolerance(tolerance), max_levels(max_levels) {}
+
+
+  field compute_integral() override;
+  Integration_Result<field> compute_with_error() override;
+
+
+  ~Romberg() {}
+
+
+  double tolerance;
+  unsigned int max_levels;
+
+  // The following ones are set by compute_integral().
+
+  double error_estimate = 0;
+  std::size_t evaluations = 0;
+  bool converged = false;
+  unsigned int levels = 0;
+};
+
+
+
+
+/* Clenshaw-Curtis integration with increasing order. On each one of the subdivision_n subintervals we use the
+Clenshaw-Curtis rule of level 0, 1, 2, ... (2^level + 1 Chebyshev points, see Gauss_Nodes.hpp), whose nodes are
+nested: going from one level to the next one we only evaluate the integrand in the 2^level new points of each
+subinterval, and reuse all the previous evaluations. Unlike Gaussian rules, whose nodes change completely when
+number_of_nodes is increased, no evaluation is wasted.
+We stop when the results of two consecutive levels differ by less than the tolerance (at level 2 at least), or at
+max_level. As for Romberg, error_estimate, evaluations, converged and level (the last level used) are set by
+compute_integral(). The new points of each level are evaluated by num_threads threads; the sums do not depend on
+it.
+The endpoints shared by two subintervals are evaluated twice, so subdivision_n should be small: the order is
+increased instead. */
+
+
+template <typename field>
+class Clenshaw_Curtis : public Integration<field> {
+  public:
+  Clenshaw_Curtis(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand, const double &tolerance = 1e-10, const unsigned int &max_level = 12) :
+  Integration<field>(begin, end, subdivision_n, integrand), tolerance(tolerance), max_level(max_level) {}
+
+  Clenshaw_Curtis(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand, const double &tolerance = 1e-10, const unsigned int &max_level = 12) :
+  Integration<field>(begin, end, subdivision_n, batch_integrand), tolerance(tolerance), max_level(max_level) {}
+
+
+  field compute_integral() override; // Throws an exception if max_level is larger than max_clenshaw_curtis_level or subdivision_n is 0
+  Integration_Result<field> compute_with_error() override;
+
+
+  ~Clenshaw_Curtis() {}
+
+
+  double tolerance;
+  unsigned int max_level;
+
+  // The following ones are set by compute_integral().
+
+  double error_estimate = 0;
+  std::size_t evaluations = 0;
+  bool converged = false;
+  unsigned int level = 0;
+};
+
+
+
+
+/* Double exponential (tanh-sinh) integration. On each subinterval, the substitution x = center + h/2*t with
+t = tanh(pi/2*sinh(u)) turns the integral in one on the real line, whose integrand decays double exponentially:
+the trapezoidal rule in u then converges exponentially fast, also when the integrand has (integrable) singularities
+at the endpoints, e.g. sqrt(x*(1-x)) or 1/sqrt(x), which are never evaluated. The nodes and the weights are taken
+from the cached tables of Gauss_Nodes.hpp.
+At each level the step in u is halved, so the integrand is only evaluated in the new nodes and the previous sum is
+reused. We stop when two consecutive levels differ by less than the tolerance (at level 2 at least) or at
+max_level. The nodes which are so close to an endpoint that they coincide with it in double precision are skipped.
+error_estimate, evaluations, converged and level are set by compute_integral(), as for Clenshaw_Curtis. */
+
+
+template <typename field>
+class Double_Exponential : public Integration<field> {
+  public:
+  Double_Exponential(const double &begin, const double &end, const unsigned int& subdivision_n, std::function<field(double)> integrand, const double &tolerance = 1e-10, const unsigned int &max_level = 8) :
+  Integration<field>(begin, end, subdivision_n, integrand), tolerance(tolerance), max_level(max_level) {}
+
+  Double_Exponential(const double &begin, const double &end, const unsigned int& subdivision_n, Batch_Integrand<field> batch_integrand, const double &tolerance = 1e-10, const unsigned int &max_level = 8) :
+  Integration<field>(begin, end, subdivision_n, batch_integrand), tolerance(tolerance), max_level(max_level) {}
+
+
+  field compute_integral() override; // Throws an exception if subdivision_n is 0
+  Integration_Result<field> compute_with_error() override;
+
+
+  ~Double_Exponential() {}
+
+
+  double tolerance;
+  unsigned int max_level;
+
+  // The following ones are set by compute_integral().
+
+  double error_estimate = 0;
+  std::size_t evaluations = 0;
+  bool converged = false;
+  unsigned int level = 0;
+};
+
+
+
+
+/* The following function integrates the same integrand on many intervals at once (e.g. on the bins of a
+spectrum), returning the results in the same order as the intervals. Each interval is divided in subdivision_n
+subintervals and rule can be "Midpoint", "Trapezoidal", "Simpson" or "Gaussian" (Gauss-Legendre with
+number_of_nodes nodes); an exception is thrown for any other rule.
+
+Compared with creating one integrator for each interval, no object is created at all: the reference Gaussian
+rule is taken from the cache only once, and the intervals are distributed among num_threads threads (0 means the
+default number, see Thread_Pool.hpp). Each result is exactly the one the corresponding integrator would return. */
+
+
+template <typename field>
+std::vector<field> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<field(double)> integrand, const unsigned int &number_of_nodes = 5, const unsigned int &num_threads = 0);
+
+template <typename field>
+std::vector<field> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, Batch_Integrand<field> batch_integrand, const unsigned int &number_of_nodes = 5, const unsigned int &num_threads = 0);
+
+
+
+
+
+/* Convergence studies. The following function integrates the integrand on [begin, end] with each one of the
+given values of subdivision_n (the levels are computed in parallel, by num_threads threads) and compares the
+results with the exact value. The order of convergence p is then estimated by a least-squares fit of
+log(error) = c - p*log(subdivision_n) over all the levels, which is much more robust than comparing two levels;
+the levels whose error is at the level of the rounding errors are not used. If less than two levels can be used,
+convergence_order is NaN. An exception is thrown if one of the values of subdivision_n is 0. As for integrate_many,
+rule can be "Midpoint", "Trapezoidal", "Simpson" or "Gaussian" (Gauss-Legendre with number_of_nodes nodes).
+
+The function polynomial_order() returns the largest k such that the (non-composite) rule integrates exactly on
+[0, 1] all the powers x^j with j <= k (at most max_degree). */
+
+
+template <typename field>
+struct Convergence_Study {
+  std::vector<unsigned int> subdivisions;
+  std::vector<field> results;
+  std::vector<double> errors; // Absolute errors, one for each level
+  double convergence_order = std::numeric_limits<double>::quiet_NaN();
+  unsigned int levels_used = 0; // Number of levels used in the fit
+};
+
+
+template <typename field>
+Convergence_Study<field> convergence_study(const std::string &rule, std::function<field(double)> integrand, const field &exact, const std::vector<unsigned int> &subdivisions, const double &begin = 0, const double &end = 1, const unsigned int &number_of_nodes = 5, const unsigned int &num_threads = 0);
+
+unsigned int polynomial_order(const std::string &rule, const unsigned int &number_of_nodes = 5, const unsigned int &max_degree = 100);
+
+
+
+
+/* The following class integrates vector-valued functions, i.e. integrands computing number_of_outputs values in
+each point (e.g. the first K moments, or K Fourier coefficients, sharing an expensive evaluation). The integrand
+writes the values in one point in out[0], ..., out[number_of_outputs-1]; a batch integrand receives n points and
+writes the k-th value in the i-th point in out[k*n + i] (see Integration_Kernels.hpp). All the integrals are
+computed in one sweep over the nodes, evaluating the integrand only once in each node.
+
+It is not derived from Integration, since compute_integral() returns number_of_outputs values. As for
+integrate_many, rule can be "Midpoint", "Trapezoidal", "Simpson" or "Gaussian" (Gauss-Legendre with
+number_of_nodes nodes). If the number of outputs is known at compile time, it is also possible to use the
+functions make_[rule] of Integration_Kernels.hpp with an integrand returning a std::array. */
+
+
+template <typename field>
+using Vector_Integrand = std::function<void(double x, field* out)>;
+
+
+template <typename field>
+class Vector_Integration {
+public:
+  Vector_Integration(const double &begin, const double &end, const unsigned int &subdivision_n, const std::size_t &number_of_outputs, Vector_Integrand<field> integrand, const std::string &rule = "Simpson", const unsigned int &number_of_nodes = 5) :
+  begin(begin), end(end), subdivision_n(subdivision_n), number_of_outputs(number_of_outputs), integrand(integrand), rule(rule), number_of_nodes(number_of_nodes), h((end-begin)/subdivision_n) {}
+
+  Vector_Integration(const double &begin, const double &end, const unsigned int &subdivision_n, const std::size_t &number_of_outputs, Batch_Integrand<field> batch_integrand, const std::string &rule = "Simpson", const unsigned int &number_of_nodes = 5) :
+  begin(begin), end(end), subdivision_n(subdivision_n), number_of_outputs(number_of_outputs), batch_integrand(batch_integrand), rule(rule), number_of_nodes(number_of_nodes), h((end-begin)/subdivision_n) {}
+
+
+  std::vector<field> compute_integral() const;
+
+
+  const double begin;
+  const double end;
+  const unsigned int subdivision_n;
+  const std::size_t number_of_outputs;
+  Vector_Integrand<field> integrand; // Empty if a batch integrand was given
+  Batch_Integrand<field> batch_integrand; // Empty unless a batch integrand was given
+  std::string rule;
+  unsigned int number_of_nodes;
+  double h;
+  unsigned int num_threads = 0; // As for Integration
+};
+
+
+
+/* The following functions split a complex function in its real and imaginary part. The integrators do not need
+them (complex integrands are integrated directly), but they are useful e.g. to compare our results with the ones
+of libraries which only integrate real functions. */
 
 inline double real_part(std::function<std::complex<double>(double)> foonction, double x) {return std::real(foonction(x));}
 
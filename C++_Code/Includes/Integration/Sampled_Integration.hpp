@@ -0,0 +1,66 @@
+#ifndef Sampled_Integration_Hpp
+#define Sampled_Integration_Hpp
+
+#include <vector>
+#include <string>
+#include <complex>
+#include <cstddef>
+#include "Integration_Kernels.hpp"
+
+
+
+/* In this header we define the integration of sampled data: instead of an integrand, we are given its values
+y[0], ..., y[n-1] in the points x[0] < ... < x[n-1] (which do not need to be equally spaced), e.g. measurements.
+The integral on [x[0], x[n-1]] is computed with the rule chosen through the attribute rule:
+
+- "Trapezoidal": the integral of the piecewise linear interpolant, sum of (x[i+1]-x[i])*(y[i]+y[i+1])/2.
+
+- "Simpson": the integral of the parabola through x[2k], x[2k+1], x[2k+2] on each pair of intervals (the usual
+  Simpson rule when the points are equally spaced). If the number of intervals is odd, the last one is integrated
+  with the parabola through the last three points, so that the rule is still exact for polynomials of degree 2.
+
+- "Spline": the integral of the cubic spline interpolating the data with the not-a-knot conditions (the same ones
+  used by default by SciPy's CubicSpline), i.e. the sum of (x[i+1]-x[i])*(y[i]+y[i+1])/2 - (x[i+1]-x[i])^3*
+  (M[i]+M[i+1])/24, where M are the second derivatives of the spline, obtained solving a tridiagonal system.
+  It is exact for polynomials of degree 3.
+
+With two points all the rules reduce to the trapezoidal one and with three points the spline rule reduces to the
+Simpson one (the not-a-knot spline is then the interpolating parabola).
+
+
+The object does not own the data: x and y are pointers to arrays which must be alive when compute_integral() is
+called (in this way the Python bindings pass the buffers of NumPy arrays without copying them), and x is checked
+once by the constructor (repeated points would divide by zero, decreasing ones would give meaningless results). If
+x is nullptr, the points are equally spaced with distance dx. As for the other integrators, the sums over the intervals are
+split in chunks of kernel_chunk_size terms, computed by num_threads threads and added pairwise, so the result does
+not depend on the number of threads. The tridiagonal system of the spline rule is solved serially, in O(n). */
+
+
+template <typename field>
+class Sampled_Integration {
+public:
+  // The constructors throw an exception if there are less than two samples, x is not strictly increasing or dx is not positive.
+
+  Sampled_Integration(const double* x, const field* y, const std::size_t &n, const std::string &rule = "Trapezoidal");
+
+  Sampled_Integration(const double &dx, const field* y, const std::size_t &n, const std::string &rule = "Trapezoidal");
+
+
+  field compute_integral() const; // Throws an exception if there are less than two samples or the rule is not valid
+
+
+  // The length of the interval [x[i], x[i+1]].
+
+  double spacing(const std::size_t &i) const {return x ? x[i+1] - x[i] : dx;}
+
+
+  const double* x = nullptr; // nullptr if the points are equally spaced
+  double dx = 1;
+  const field* y;
+  std::size_t n;
+  std::string rule;
+  unsigned int num_threads = 0; // See Thread_Pool.hpp
+};
+
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef Thread_Pool_Hpp
+#define Thread_Pool_Hpp
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <type_traits>
+
+
+
+/* In this header we define the pool of threads used by the integrators when they are asked to run in parallel.
+
+Creating threads is expensive, so the threads are created once and then wait for jobs to run. The pool used by
+the integrators is the one returned by global_thread_pool(): it starts without threads and creates them the first
+time they are needed, so that the users who never ask for parallel execution never pay for it.
+
+The main method is parallel_for(), which runs task(0), ..., task(number_of_tasks-1) using at most
+number_of_threads threads. The calling thread takes part in the work as well, so that the tasks are completed
+even if all the threads of the pool are busy; for the same reason, a parallel_for() called from inside a task
+(e.g. an integrand which computes another integral) is simply run serially by the thread calling it.
+
+The tasks are taken in increasing order by whichever thread is free, so the order in which they are run is not
+fixed: the tasks must write their results in different places (e.g. one entry of a vector per task), and it is up
+to the caller to combine them in a fixed order (see Integration_Kernels.hpp). */
+
+
+class Thread_Pool {
+public:
+  explicit Thread_Pool(const unsigned int &number_of_workers = 0);
+
+  Thread_Pool(const Thread_Pool&) = delete;
+  Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+  ~Thread_Pool(); // Waits for the jobs already submitted and stops the threads
+
+
+  // Creates new threads until there are at least number_of_workers of them.
+
+  void reserve(const unsigned int &number_of_workers);
+
+  unsigned int size() const;
+
+
+  /* Runs task() in one of the threads of the pool. The result (or the exception thrown by the task) can be
+  retrieved through the returned future. */
+
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F task) {
+    auto packaged = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(task));
+    std::future<std::invoke_result_t<F>> result = packaged->get_future();
+    if (size() == 0) {reserve(1);}
+    enqueue([packaged](){(*packaged)();});
+    return result;
+  }
+
+
+  /* See the comment above. If one of the tasks throws an exception, the remaining tasks are not started and the
+  exception is rethrown by parallel_for() once the tasks already started are completed. */
+
+  void parallel_for(const std::size_t &number_of_tasks, const unsigned int &number_of_threads, const std::function<void(std::size_t)> &task);
+
+
+protected:
+  void enqueue(std::function<void()> job);
+  void work(); // The loop run by each thread
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> jobs;
+  mutable std::mutex mutex;
+  std::condition_variable job_available;
+  bool stopping = false;
+};
+
+
+
+// The pool shared by all the integrators.
+
+Thread_Pool& global_thread_pool();
+
+
+
+/* The number of threads used by the integrators whose attribute num_threads is 0. It is 1 unless it is changed,
+i.e. parallel execution must be explicitly requested; setting it to 0 means "use all the available cores". */
+
+void set_default_num_threads(const unsigned int &num_threads);
+
+unsigned int get_default_num_threads();
+
+
+
+// Converts the attribute num_threads of an integrator in the actual number of threads to use (always at least 1).
+
+unsigned int resolve_num_threads(const unsigned int &num_threads);
+
+
+#endif
@@ -0,0 +1,308 @@
+#include "../../Includes/Integration/Expression.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+
+
+namespace {
+
+  using Opcode = Expression::Opcode;
+  using Instruction = Expression::Instruction;
+
+
+  const std::vector<std::pair<std::string, Opcode>> function_names = {
+    {"sin", Opcode::Sin}, {"cos", Opcode::Cos}, {"tan", Opcode::Tan}, {"asin", Opcode::Asin}, {"acos", Opcode::Acos},
+    {"atan", Opcode::Atan}, {"sinh", Opcode::Sinh}, {"cosh", Opcode::Cosh}, {"tanh", Opcode::Tanh}, {"exp", Opcode::Exp},
+    {"log", Opcode::Log}, {"log10", Opcode::Log10}, {"sqrt", Opcode::Sqrt}, {"abs", Opcode::Abs}
+  };
+
+
+  constexpr int max_integer_exponent = 64;
+
+
+
+  /* A recursive descent parser, emitting the instructions while it reads the string. The value of the
+  subexpression being parsed is written in the register depth, so a binary operation reads the registers
+  depth-2 and depth-1 and writes the first one. */
+
+  class Compiler {
+  public:
+    Compiler(const std::string &source, std::vector<Instruction> &program) : source(source), program(program) {}
+
+
+    unsigned int compile() {
+      expression();
+      skip_spaces();
+      if (position != source.size()) {error("unexpected '" + std::string(1, source[position]) + "'");}
+      return max_depth;
+    }
+
+
+  private:
+
+    [[noreturn]] void error(const std::string &message) const {
+      throw std::runtime_error("Invalid expression '" + source + "': " + message + " at position " + std::to_string(position) + ".");
+    }
+
+    void skip_spaces() {
+      while (position < source.size() && std::isspace(static_cast<unsigned char>(source[position]))) {++position;}
+    }
+
+    bool accept(const std::string &token) {
+      skip_spaces();
+      if (source.compare(position, token.size(), token) != 0) {return false;}
+      position += token.size();
+      return true;
+    }
+
+
+    void push(Instruction instruction) {
+      instruction.target = depth;
+      program.push_back(instruction);
+      max_depth = std::max(max_depth, ++depth);
+    }
+
+    bool top_is_constant(const unsigned int &count) const {
+      if (program.size() < count) {return false;}
+      for (unsigned int k = 1; k <= count; ++k) {
+        const Instruction &instruction = program[program.size() - k];
+        if (instruction.opcode != Opcode::Constant || instruction.target != depth - k) {return false;}
+      }
+      return true;
+    }
+
+
+    /* Emits the operation on the last count registers (count = 1 or 2). If they are all constants, the operation
+    is executed immediately and replaced by its result. */
+
+    void operation(Instruction instruction, const unsigned int &count) {
+      instruction.target = instruction.first = depth - count;
+      if (count == 2) {instruction.second = depth - 1;}
+
+      if (top_is_constant(count)) {
+        std::vector<double> values(depth);
+        for (unsigned int k = 1; k <= count; ++k) {values[depth - k] = program[program.size() - k].constant;}
+        Expression::execute(instruction, values.data(), 1, nullptr, 1);
+        program.resize(program.size() - count);
+        depth -= count;
+        push(Instruction{Opcode::Constant, 0, 0, 0, values[instruction.target]});
+        return;
+      }
+
+      program.push_back(instruction);
+      depth -= count - 1;
+    }
+
+
+    // expression := term (('+' | '-') term)*
+
+    void expression() {
+      term();
+      while (true) {
+        if (accept("+")) {term(); operation(Instruction{Opcode::Add, 0}, 2);}
+        else if (accept("-")) {term(); operation(Instruction{Opcode::Subtract, 0}, 2);}
+        else {return;}
+      }
+    }
+
+    // term := unary (('*' | '/') unary)*, where '*' must not be the beginning of '**'
+
+    void term() {
+      unary();
+      while (true) {
+        skip_spaces();
+        if (source.compare(position, 2, "**") != 0 && accept("*")) {unary(); operation(Instruction{Opcode::Multiply, 0}, 2);}
+        else if (accept("/")) {unary(); operation(Instruction{Opcode::Divide, 0}, 2);}
+        else {return;}
+      }
+    }
+
+    // unary := ('-' | '+') unary | power
+
+    void unary() {
+      if (accept("-")) {unary(); operation(Instruction{Opcode::Negate, 0}, 1);}
+      else if (accept("+")) {unary();}
+      else {power();}
+    }
+
+    /* power := primary (('^' | '**') unary)?, which is right-associative since the exponent can be a power itself.
+    A constant integer exponent is replaced by Integer_Power. */
+
+    void power() {
+      primary();
+      if (!accept("^") && !accept("**")) {return;}
+      unary();
+      if (top_is_constant(1)) {
+        const double exponent = program.back().constant;
+        if (exponent == std::floor(exponent) && std::abs(exponent) <= max_integer_exponent) {
+          program.pop_back();
+          --depth;
+          Instruction instruction{Opcode::Integer_Power, 0};
+          instruction.exponent = static_cast<int>(exponent);
+          operation(instruction, 1);
+          return;
+        }
+      }
+      operation(Instruction{Opcode::Power, 0}, 2);
+    }
+
+    // primary := number | 'x' | 'pi' | 'e' | function '(' expression ')' | '(' expression ')'
+
+    void primary() {
+      skip_spaces();
+      if (position == source.size()) {error("unexpected end");}
+
+      const char c = source[position];
+
+      if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+        const char* begin = source.c_str() + position;
+        char* end = nullptr;
+        const double value = std::strtod(begin, &end);
+        if (end == begin) {error("invalid number");}
+        position += static_cast<std::size_t>(end - begin);
+        push(Instruction{Opcode::Constant, 0, 0, 0, value});
+        return;
+      }
+
+      if (accept("(")) {
+        expression();
+        if (!accept(")")) {error("expected ')'");}
+        return;
+      }
+
+      if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_') {error("unexpected '" + std::string(1, c) + "'");}
+
+      const std::size_t start = position;
+      while (position < source.size() && (std::isalnum(static_cast<unsigned char>(source[position])) || source[position] == '_')) {++position;}
+      const std::string name = source.substr(start, position - start);
+
+      if (name == "x") {push(Instruction{Opcode::Variable, 0}); return;}
+      if (name == "pi") {push(Instruction{Opcode::Constant, 0, 0, 0, std::acos(-1.0)}); return;}
+      if (name == "e") {push(Instruction{Opcode::Constant, 0, 0, 0, std::exp(1.0)}); return;}
+
+      for (const auto &[function_name, opcode] : function_names) {
+        if (name != function_name) {continue;}
+        if (!accept("(")) {error("expected '(' after " + name);}
+        expression();
+        if (!accept(")")) {error("expected ')'");}
+        operation(Instruction{opcode, 0}, 1);
+        return;
+      }
+
+      position = start;
+      error("unknown name '" + name + "'");
+    }
+
+
+    const std::string &source;
+    std::vector<Instruction> &program;
+    std::size_t position = 0;
+    unsigned int depth = 0;
+    unsigned int max_depth = 0;
+  };
+
+
+
+  template <typename Function>
+  inline void unary_loop(double* target, const double* a, const std::size_t &n, Function f) {
+    for (std::size_t k = 0; k < n; ++k) {target[k] = f(a[k]);}
+  }
+
+  template <typename Function>
+  inline void binary_loop(double* target, const double* a, const double* b, const std::size_t &n, Function f) {
+    for (std::size_t k = 0; k < n; ++k) {target[k] = f(a[k], b[k]);}
+  }
+
+}
+
+
+
+Expression::Expression(const std::string &source) : source(source) {
+  registers = Compiler(source, program).compile();
+}
+
+
+
+void Expression::execute(const Instruction &instruction, double* registers_data, const std::size_t &stride, const double* x, const std::size_t &n) {
+
+  double* target = registers_data + instruction.target*stride;
+  const double* a = registers_data + instruction.first*stride;
+  const double* b = registers_data + instruction.second*stride;
+
+  switch (instruction.opcode) {
+    case Opcode::Variable: std::copy(x, x + n, target); break;
+    case Opcode::Constant: std::fill(target, target + n, instruction.constant); break;
+    case Opcode::Add: binary_loop(target, a, b, n, [](double u, double v){return u + v;}); break;
+    case Opcode::Subtract: binary_loop(target, a, b, n, [](double u, double v){return u - v;}); break;
+    case Opcode::Multiply: binary_loop(target, a, b, n, [](double u, double v){return u*v;}); break;
+    case Opcode::Divide: binary_loop(target, a, b, n, [](double u, double v){return u/v;}); break;
+    case Opcode::Power: binary_loop(target, a, b, n, [](double u, double v){return std::pow(u, v);}); break;
+    case Opcode::Negate: unary_loop(target, a, n, [](double u){return -u;}); break;
+
+    case Opcode::Integer_Power: {
+      const int exponent = instruction.exponent;
+      const unsigned int magnitude = static_cast<unsigned int>(std::abs(exponent));
+      unary_loop(target, a, n, [exponent, magnitude](double u){
+        double result = 1;
+        for (unsigned int e = magnitude; e > 0; e >>= 1) { // Exponentiation by squaring
+          if (e & 1) {result *= u;}
+          u *= u;
+        }
+        return (exponent < 0) ? 1/result : result;
+      });
+      break;
+    }
+
+    case Opcode::Sin: unary_loop(target, a, n, [](double u){return std::sin(u);}); break;
+    case Opcode::Cos: unary_loop(target, a, n, [](double u){return std::cos(u);}); break;
+    case Opcode::Tan: unary_loop(target, a, n, [](double u){return std::tan(u);}); break;
+    case Opcode::Asin: unary_loop(target, a, n, [](double u){return std::asin(u);}); break;
+    case Opcode::Acos: unary_loop(target, a, n, [](double u){return std::acos(u);}); break;
+    case Opcode::Atan: unary_loop(target, a, n, [](double u){return std::atan(u);}); break;
+    case Opcode::Sinh: unary_loop(target, a, n, [](double u){return std::sinh(u);}); break;
+    case Opcode::Cosh: unary_loop(target, a, n, [](double u){return std::cosh(u);}); break;
+    case Opcode::Tanh: unary_loop(target, a, n, [](double u){return std::tanh(u);}); break;
+    case Opcode::Exp: unary_loop(target, a, n, [](double u){return std::exp(u);}); break;
+    case Opcode::Log: unary_loop(target, a, n, [](double u){return std::log(u);}); break;
+    case Opcode::Log10: unary_loop(target, a, n, [](double u){return std::log10(u);}); break;
+    case Opcode::Sqrt: unary_loop(target, a, n, [](double u){return std::sqrt(u);}); break;
+    case Opcode::Abs: unary_loop(target, a, n, [](double u){return std::abs(u);}); break;
+  }
+}
+
+
+
+// The registers of a block are allocated by each call, so that different threads never share them.
+
+void Expression::operator()(const double* x, std::size_t n, double* out) const {
+  const std::size_t block = std::min(n, block_size);
+  std::vector<double> registers_data(std::max(1u, registers)*block);
+
+  for (std::size_t j = 0; j < n; j += block) {
+    const std::size_t count = std::min(block, n - j);
+    for (const Instruction &instruction : program) {execute(instruction, registers_data.data(), block, x + j, count);}
+    std::copy(registers_data.data(), registers_data.data() + count, out + j); // The result is in the register 0
+  }
+}
+
+
+
+void Expression::operator()(const double* x, std::size_t n, std::complex<double>* out) const {
+  std::vector<double> values(std::min(n, block_size));
+  for (std::size_t j = 0; j < n; j += block_size) {
+    const std::size_t count = std::min(block_size, n - j);
+    (*this)(x + j, count, values.data());
+    std::copy(values.data(), values.data() + count, out + j);
+  }
+}
+
+
+
+double Expression::operator()(double x) const {
+  double result;
+  (*this)(&x, 1, &result);
+  return result;
+}
@@ -0,0 +1,399 @@
+#include "../../Includes/Integration/Gauss_Nodes.hpp"
+#include "../../Includes/Integration/Gauss_Tables.hpp"
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <complex>
+
+
+
+/* The nodes and the weights are computed by us, without relying on external libraries.
+
+For Gauss-Legendre with few nodes we just copy the precomputed tables of Gauss_Tables.hpp, while the two
+Chebyshev families have closed-form nodes and weights.
+All the other cases are computed using the Golub-Welsch algorithm: if the orthogonal polynomials satisfy the three
+term recurrence relation
+      sqrt(b_(k+1)) p_(k+1)(t) = (t - a_k) p_k(t) - sqrt(b_k) p_(k-1)(t),
+then the nodes are the eigenvalues of the symmetric tridiagonal (Jacobi) matrix having a_k on the diagonal and
+sqrt(b_k) on the off-diagonal, while the weights are mu_0 * v_0^2, where v_0 is the first component of the
+normalized eigenvector and mu_0 is the integral of the weight function.
+
+The weight functions on [-1, 1] are the same ones used by the GNU GSL, so that the results did not change after
+removing it: Gegenbauer is (1-t^2)^alpha, Jacobi is (1-t)^alpha (1+t)^beta and Exponential is |t|^alpha. */
+
+
+namespace {
+
+  using Rule_Key = std::tuple<std::string, unsigned int, double, double>;
+
+
+  std::map<Rule_Key, std::shared_ptr<const Gauss_Rule>> rule_cache;
+  std::mutex rule_cache_mutex;
+
+  std::map<unsigned int, std::shared_ptr<const Gauss_Rule>> clenshaw_curtis_cache;
+  std::map<unsigned int, std::shared_ptr<const Tanh_Sinh_Level>> tanh_sinh_cache;
+
+
+
+  /* The following function computes the eigenvalues of a symmetric tridiagonal matrix and the first component of
+  its eigenvectors using the implicit QL method (see e.g. Golub and Welsch, "Calculation of Gauss quadrature
+  rules", 1969, or the routine imtqlx by Elhay and Kautsky).
+  On input diag contains the diagonal, sub_diag the off-diagonal (sub_diag[i] couples i and i+1) and z the vector
+  (sqrt(mu_0), 0, ..., 0); on output diag contains the nodes and z^2 the weights. */
+
+  void implicit_ql(std::vector<double> &diag, std::vector<double> &sub_diag, std::vector<double> &z) {
+
+    const size_t n = diag.size();
+    const double precision = std::numeric_limits<double>::epsilon();
+    const unsigned int max_iterations = 30;
+
+    if (n == 1) {return;}
+
+    sub_diag[n-1] = 0.0;
+
+    for (size_t l = 0; l < n; ++l) {
+
+      unsigned int iterations = 0;
+
+      while (true) {
+
+        size_t m = l;
+        for (; m < n-1; ++m) {
+          if (std::abs(sub_diag[m]) <= precision*(std::abs(diag[m]) + std::abs(diag[m+1]))) {break;}
+        }
+
+        double p = diag[l];
+        if (m == l) {break;}
+
+        if (iterations == max_iterations) {throw std::runtime_error("The computation of the Gaussian nodes did not converge.");}
+        ++iterations;
+
+        double g = (diag[l+1] - p)/(2.0*sub_diag[l]);
+        double r = std::sqrt(g*g + 1.0);
+        g = diag[m] - p + sub_diag[l]/(g + std::copysign(r, g));
+
+        double s = 1.0;
+        double c = 1.0;
+        p = 0.0;
+
+        for (size_t i = m; i-- > l;) {
+
+          double f = s*sub_diag[i];
+          double b = c*sub_diag[i];
+
+          if (std::abs(g) <= std::abs(f)) {
+            c = g/f;
+            r = std::sqrt(c*c + 1.0);
+            sub_diag[i+1] = f*r;
+            s = 1.0/r;
+            c *= s;
+          }
+          else {
+            s = f/g;
+            r = std::sqrt(s*s + 1.0);
+            sub_diag[i+1] = g*r;
+            c = 1.0/r;
+            s *= c;
+          }
+
+          g = diag[i+1] - p;
+          r = (diag[i] - g)*s + 2.0*c*b;
+          p = s*r;
+          diag[i+1] = g + p;
+          g = c*r - b;
+
+          f = z[i+1];
+          z[i+1] = s*z[i] + c*f;
+          z[i] = c*z[i] - s*f;
+        }
+
+        diag[l] -= p;
+        sub_diag[l] = g;
+        sub_diag[m] = 0.0;
+      }
+    }
+  }
+
+
+
+  // Golub-Welsch: from the recurrence coefficients to the (sorted) nodes and weights.
+
+  void golub_welsch(std::vector<double> diag, std::vector<double> sub_diag, const double &mu_0, Gauss_Rule &rule) {
+
+    const size_t n = diag.size();
+
+    std::vector<double> z(n, 0.0);
+    z[0] = std::sqrt(mu_0);
+    sub_diag.resize(n, 0.0);
+
+    implicit_ql(diag, sub_diag, z);
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&diag](size_t i, size_t j){return diag[i] < diag[j];});
+
+    rule.nodes.resize(n);
+    rule.weights.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+      rule.nodes[k] = diag[order[k]];
+      rule.weights[k] = z[order[k]]*z[order[k]];
+    }
+  }
+
+
+
+  /* Recurrence coefficients of the Jacobi polynomials, orthogonal with respect to (1-t)^alpha (1+t)^beta.
+  Legendre and Gegenbauer are particular cases. The first terms are written separately since the general formulas
+  contain a 0/0 when alpha + beta is equal to 0 or to -1. */
+
+  void jacobi_rule(const unsigned int &n, const double &alpha, const double &beta, Gauss_Rule &rule) {
+
+    if (alpha <= -1 || beta <= -1) {throw std::runtime_error("Jacobi and Gegenbauer integration require alpha > -1 (and beta > -1).");}
+
+    const double ab = alpha + beta;
+    std::vector<double> diag(n), sub_diag(n > 1 ? n-1 : 0);
+
+    diag[0] = (beta - alpha)/(ab + 2.0);
+    for (unsigned int k = 1; k < n; ++k) {
+      diag[k] = (beta*beta - alpha*alpha)/((2.0*k + ab)*(2.0*k + ab + 2.0));
+    }
+
+    if (n > 1) {sub_diag[0] = std::sqrt(4.0*(alpha + 1.0)*(beta + 1.0)/((ab + 2.0)*(ab + 2.0)*(ab + 3.0)));}
+    for (unsigned int k = 2; k < n; ++k) {
+      double twok_ab = 2.0*k + ab;
+      sub_diag[k-1] = std::sqrt(4.0*k*(k + alpha)*(k + beta)*(k + ab)/(twok_ab*twok_ab*(twok_ab + 1.0)*(twok_ab - 1.0)));
+    }
+
+    const double mu_0 = std::exp((ab + 1.0)*std::log(2.0) + std::lgamma(alpha + 1.0) + std::lgamma(beta + 1.0) - std::lgamma(ab + 2.0));
+
+    golub_welsch(diag, sub_diag, mu_0, rule);
+  }
+
+
+
+  // Generalized Hermite-like polynomials on [-1, 1], orthogonal with respect to |t|^alpha.
+
+  void exponential_rule(const unsigned int &n, const double &alpha, Gauss_Rule &rule) {
+
+    if (alpha <= -1) {throw std::runtime_error("Exponential integration requires alpha > -1.");}
+
+    std::vector<double> diag(n, 0.0), sub_diag(n > 1 ? n-1 : 0);
+
+    double a2k = alpha;
+    for (unsigned int k = 1; k < n; ++k) {
+      a2k += 2.0;
+      sub_diag[k-1] = (k + alpha*(k % 2))/std::sqrt(a2k*a2k - 1.0);
+    }
+
+    golub_welsch(diag, sub_diag, 2.0/(alpha + 1.0), rule);
+  }
+
+
+
+  std::shared_ptr<const Gauss_Rule> compute_rule(const std::string &family, const unsigned int &n, const double &alpha, const double &beta) {
+
+    if (n == 0) {throw std::runtime_error("The number of nodes must be positive.");}
+
+    const double pi = std::acos(-1.0);
+    std::shared_ptr<Gauss_Rule> rule = std::make_shared<Gauss_Rule>();
+
+    if (family == "Legendre") {
+      rule->scaling_exponent = 1;
+
+      if (n <= legendre_table_max_nodes) {
+        const unsigned int offset = legendre_table_offset(n);
+        rule->nodes.assign(legendre_table_nodes + offset, legendre_table_nodes + offset + n);
+        rule->weights.assign(legendre_table_weights + offset, legendre_table_weights + offset + n);
+      }
+      else {jacobi_rule(n, 0.0, 0.0, *rule);}
+    }
+
+    else if (family == "Chebyshev Type 1") {
+      rule->scaling_exponent = 0;
+      for (unsigned int k = n; k >= 1; --k) {
+        rule->nodes.push_back(std::cos((2.0*k - 1.0)*pi/(2.0*n)));
+        rule->weights.push_back(pi/n);
+      }
+    }
+
+    else if (family == "Chebyshev Type 2") {
+      rule->scaling_exponent = 2;
+      for (unsigned int k = n; k >= 1; --k) {
+        double s = std::sin(k*pi/(n + 1.0));
+        rule->nodes.push_back(std::cos(k*pi/(n + 1.0)));
+        rule->weights.push_back(pi/(n + 1.0)*s*s);
+      }
+    }
+
+    else if (family == "Gegenbauer") {rule->scaling_exponent = 2*alpha+1; jacobi_rule(n, alpha, alpha, *rule);}
+    else if (family == "Jacobi") {rule->scaling_exponent = alpha+beta+1; jacobi_rule(n, alpha, beta, *rule);}
+    else if (family == "Exponential") {rule->scaling_exponent = alpha+1; exponential_rule(n, alpha, *rule);}
+    else {throw std::runtime_error("Invalid family of polynomials.");}
+
+    return rule;
+  }
+
+}
+
+
+
+namespace {
+
+  // In-place radix-2 FFT (decimation in time); the size of data must be a power of 2.
+
+  void fft(std::vector<std::complex<double>> &data) {
+    const std::size_t n = data.size();
+
+    for (std::size_t i = 1, j = 0; i < n; ++i) { // Bit-reversal permutation
+      std::size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1) {j ^= bit;}
+      j ^= bit;
+      if (i < j) {std::swap(data[i], data[j]);}
+    }
+
+    const double pi = std::acos(-1.0);
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+      for (std::size_t k = 0; k < length/2; ++k) {
+        const std::complex<double> twiddle = std::polar(1.0, -2*pi*static_cast<double>(k)/static_cast<double>(length));
+        for (std::size_t i = 0; i < n; i += length) {
+          const std::complex<double> u = data[i + k];
+          const std::complex<double> v = data[i + k + length/2]*twiddle;
+          data[i + k] = u + v;
+          data[i + k + length/2] = u - v;
+        }
+      }
+    }
+  }
+
+
+
+  /* With n = 2^level, the weights are (see Waldvogel, "Fast construction of the Fejer and Clenshaw-Curtis
+  quadrature rules")
+        w_j = (c_j/n) * (sum over even m from 0 to n of b_m * 2/(1 - m^2) * cos(m*j*pi/n)),
+  where c_j and b_m are 1 at the extrema (j = 0, n and m = 0, n) and 2 otherwise. The sum is a discrete cosine
+  transform of type I, i.e. half the FFT of the even extension of the moments (a vector of length 2n). */
+
+  std::shared_ptr<const Gauss_Rule> compute_clenshaw_curtis_rule(const unsigned int &level) {
+
+    auto rule = std::make_shared<Gauss_Rule>();
+    rule->scaling_exponent = 1;
+
+    const std::size_t n = std::size_t(1) << level;
+    const double pi = std::acos(-1.0);
+
+    rule->nodes.resize(n + 1);
+    for (std::size_t j = 0; j <= n; ++j) {
+      rule->nodes[j] = std::sin(pi*(static_cast<double>(n) - 2.0*j)/(2.0*n)); // cos(j*pi/n), exactly antisymmetric
+    }
+
+    if (n == 1) { // The trapezoidal rule
+      rule->weights = {1.0, 1.0};
+      return rule;
+    }
+
+    std::vector<std::complex<double>> extension(2*n);
+    for (std::size_t m = 0; m <= n; m += 2) {
+      const double moment = 2.0/(1.0 - static_cast<double>(m)*static_cast<double>(m));
+      extension[m] = moment;
+      if (m != 0 && m != n) {extension[2*n - m] = moment;}
+    }
+
+    fft(extension);
+
+    rule->weights.resize(n + 1);
+    for (std::size_t j = 0; j <= n; ++j) {
+      const double c_j = (j == 0 || j == n) ? 1.0 : 2.0;
+      rule->weights[j] = c_j*extension[j].real()/(2.0*n);
+    }
+    for (std::size_t j = 0; j < n/2; ++j) { // The weights are symmetric
+      const double average = (rule->weights[j] + rule->weights[n - j])/2;
+      rule->weights[j] = rule->weights[n - j] = average;
+    }
+
+    return rule;
+  }
+
+}
+
+
+
+std::shared_ptr<const Gauss_Rule> reference_gauss_rule(const std::string &family_of_polynomials, const unsigned int &number_of_nodes, const double &alpha, const double &beta) {
+
+  // The parameters which are not used by a family are not part of the key, to avoid storing the same rule twice.
+
+  double key_alpha = (family_of_polynomials == "Gegenbauer" || family_of_polynomials == "Jacobi" || family_of_polynomials == "Exponential") ? alpha : 0.0;
+  double key_beta = (family_of_polynomials == "Jacobi") ? beta : 0.0;
+
+  Rule_Key key{family_of_polynomials, number_of_nodes, key_alpha, key_beta};
+
+  std::lock_guard<std::mutex> lock(rule_cache_mutex);
+
+  auto it = rule_cache.find(key);
+  if (it != rule_cache.end()) {return it->second;}
+
+  std::shared_ptr<const Gauss_Rule> rule = compute_rule(family_of_polynomials, number_of_nodes, key_alpha, key_beta);
+  rule_cache.emplace(key, rule);
+
+  return rule;
+}
+
+
+
+std::shared_ptr<const Gauss_Rule> reference_clenshaw_curtis_rule(const unsigned int &level) {
+
+  if (level > max_clenshaw_curtis_level) {throw std::runtime_error("The level of the Clenshaw-Curtis rule is too large.");}
+
+  std::lock_guard<std::mutex> lock(rule_cache_mutex);
+
+  auto it = clenshaw_curtis_cache.find(level);
+  if (it != clenshaw_curtis_cache.end()) {return it->second;}
+
+  std::shared_ptr<const Gauss_Rule> rule = compute_clenshaw_curtis_rule(level);
+  clenshaw_curtis_cache.emplace(level, rule);
+
+  return rule;
+}
+
+
+
+/* With v = pi/2*sinh(u) and q = exp(-2v), we have 1 - tanh(v) = 2q/(1+q) and 1/cosh(v)^2 = 4q/(1+q)^2, which can be
+computed even when cosh(v) would overflow. The weight is the derivative of t, i.e. pi/2*cosh(u)/cosh(v)^2. */
+
+std::shared_ptr<const Tanh_Sinh_Level> tanh_sinh_level(const unsigned int &level) {
+
+  if (level > 30) {throw std::runtime_error("The level of the tanh-sinh rule is too large.");}
+
+  std::lock_guard<std::mutex> lock(rule_cache_mutex);
+
+  auto it = tanh_sinh_cache.find(level);
+  if (it != tanh_sinh_cache.end()) {return it->second;}
+
+  auto table = std::make_shared<Tanh_Sinh_Level>();
+  const double pi = std::acos(-1.0);
+  const double step = std::ldexp(1.0, -static_cast<int>(level));
+
+  for (std::size_t k = 1; k*step <= tanh_sinh_max_u; k += (level == 0) ? 1 : 2) {
+    const double u = k*step;
+    const double q = std::exp(-pi*std::sinh(u));
+    table->complements.push_back(2*q/(1 + q));
+    table->weights.push_back(pi/2*std::cosh(u)*4*q/((1 + q)*(1 + q)));
+  }
+
+  tanh_sinh_cache.emplace(level, table);
+
+  return table;
+}
+
+
+
+void clear_gauss_rule_cache() {
+  std::lock_guard<std::mutex> lock(rule_cache_mutex);
+  rule_cache.clear();
+  clenshaw_curtis_cache.clear();
+  tanh_sinh_cache.clear();
+}
\ No newline at end of file
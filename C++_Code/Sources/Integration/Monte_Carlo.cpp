@@ -0,0 +1,216 @@
+#include "../../Includes/Integration/Monte_Carlo.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+
+
+namespace {
+
+  // splitmix64 (Steele, Lea, Flood, "Fast splittable pseudorandom number generators"), used as a hash of a counter.
+
+  inline std::uint64_t splitmix64(std::uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+
+  // The stream of a replicate and its counter-th number, uniformly distributed in [0, 1).
+
+  inline std::uint64_t stream_key(const std::uint64_t &seed, const unsigned int &replicate) {return splitmix64(splitmix64(seed) + replicate);}
+
+  inline double uniform(const std::uint64_t &key, const std::uint64_t &counter) {
+    return static_cast<double>(splitmix64(key + counter*0x9E3779B97F4A7C15ULL) >> 11)*0x1.0p-53;
+  }
+
+
+  inline double radical_inverse(std::size_t k, const unsigned int &base) {
+    const double inverse_base = 1.0/base;
+    double factor = inverse_base;
+    double result = 0;
+    while (k > 0) {
+      result += static_cast<double>(k % base)*factor;
+      k /= base;
+      factor *= inverse_base;
+    }
+    return result;
+  }
+
+
+
+  /* The statistics of a set of values: their number, their mean and the sum of the squared distances from the
+  mean. Two sets are merged with the formulas of Chan, Golub and LeVeque, which are stable also for many points. */
+
+  template <typename field>
+  struct Statistics {
+    double count = 0;
+    field mean{};
+    double squares = 0;
+  };
+
+
+  template <typename field>
+  Statistics<field> merged(const Statistics<field> &first, const Statistics<field> &second) {
+    if (first.count == 0) {return second;}
+    if (second.count == 0) {return first;}
+    const double count = first.count + second.count;
+    const field delta = second.mean - first.mean;
+    return {count, first.mean + delta*(second.count/count), first.squares + second.squares + std::norm(delta)*(first.count*second.count/count)};
+  }
+
+
+  template <typename field>
+  Statistics<field> pairwise_merge(const std::vector<Statistics<field>> &values, const std::size_t &first, const std::size_t &last) {
+    if (last - first == 1) {return values[first];}
+    const std::size_t middle = first + (last - first + 1)/2;
+    return merged(pairwise_merge(values, first, middle), pairwise_merge(values, middle, last));
+  }
+
+}
+
+
+
+template <typename field>
+void Monte_Carlo<field>::unit_points(const unsigned int &replicate, const std::size_t &first, const std::size_t &n, double* u) const {
+  const std::uint64_t key = stream_key(seed, replicate);
+  const std::uint64_t counter = static_cast<std::uint64_t>(first)*dimension;
+  for (std::size_t i = 0; i < n*dimension; ++i) {u[i] = uniform(key, counter + i);}
+}
+
+
+
+template <typename field>
+void Quasi_Monte_Carlo<field>::unit_points(const unsigned int &replicate, const std::size_t &first, const std::size_t &n, double* u) const {
+  const std::uint64_t key = stream_key(this->seed, replicate);
+  for (std::size_t k = 0; k < n; ++k) {
+    for (std::size_t d = 0; d < this->dimension; ++d) {
+      const double shifted = radical_inverse(first + k, primes[d]) + uniform(key, d); // The shift only depends on the direction
+      u[k*this->dimension + d] = shifted - std::floor(shifted);
+    }
+  }
+}
+
+
+
+template <typename field>
+std::vector<unsigned int> Quasi_Monte_Carlo<field>::first_primes(const std::size_t &count) {
+  std::vector<unsigned int> primes;
+  for (unsigned int candidate = 2; primes.size() < count; ++candidate) {
+    bool is_prime = true;
+    for (unsigned int p : primes) {
+      if (p*p > candidate) {break;}
+      if (candidate % p == 0) {is_prime = false; break;}
+    }
+    if (is_prime) {primes.push_back(candidate);}
+  }
+  return primes;
+}
+
+
+
+template <typename field>
+field Monte_Carlo<field>::compute_integral() {
+
+  if (dimension == 0 || end.size() != dimension) {throw std::runtime_error("begin and end must have the same (positive) length.");}
+  if (samples == 0) {throw std::runtime_error("samples must be positive.");}
+  if (replicates < minimum_replicates()) {throw std::runtime_error("At least " + std::to_string(minimum_replicates()) + " replicates are needed.");}
+
+  double volume = 1;
+  for (std::size_t d = 0; d < dimension; ++d) {volume *= end[d] - begin[d];}
+
+  // The points are generated and evaluated in blocks, whose coordinates take at most 64K doubles.
+
+  const std::size_t block = std::clamp<std::size_t>((1 << 16)/dimension, 1, kernel_block_size);
+  const std::size_t total_chunks = (samples + chunk_size - 1)/chunk_size;
+
+  std::vector<std::vector<Statistics<field>>> chunk_statistics(replicates); // chunk_statistics[r][c]
+
+  auto chunk = [&](const unsigned int &r, const std::size_t &c){
+    const std::size_t first = c*chunk_size;
+    const std::size_t last = std::min(samples, first + chunk_size);
+
+    std::vector<double> x(block*dimension);
+    std::vector<field> y(block);
+    Statistics<field> statistics;
+
+    for (std::size_t j = first; j < last; j += block) {
+      const std::size_t n = std::min(block, last - j);
+
+      unit_points(r, j, n, x.data());
+      for (std::size_t k = 0; k < n; ++k) {
+        for (std::size_t d = 0; d < dimension; ++d) {x[k*dimension + d] = begin[d] + (end[d] - begin[d])*x[k*dimension + d];}
+      }
+
+      if (batch_integrand) {batch_integrand(x.data(), n, y.data());}
+      else {for (std::size_t k = 0; k < n; ++k) {y[k] = integrand(x.data() + k*dimension);}}
+
+      Statistics<field> block_statistics{static_cast<double>(n)};
+      for (std::size_t k = 0; k < n; ++k) {block_statistics.mean += y[k];}
+      block_statistics.mean /= static_cast<double>(n);
+      for (std::size_t k = 0; k < n; ++k) {block_statistics.squares += std::norm(y[k] - block_statistics.mean);}
+
+      statistics = merged(statistics, block_statistics);
+    }
+
+    return statistics;
+  };
+
+  running_samples.clear();
+  running_errors.clear();
+  converged = false;
+
+  field result{};
+  std::size_t chunks = 0;
+
+  while (chunks < total_chunks) {
+
+    const std::size_t new_chunks = (target_error > 0) ? std::min(total_chunks, std::max<std::size_t>(1, 2*chunks)) : total_chunks;
+
+    for (std::vector<Statistics<field>> &statistics : chunk_statistics) {statistics.resize(new_chunks);}
+    global_thread_pool().parallel_for(replicates*(new_chunks - chunks), resolve_num_threads(num_threads), [&](std::size_t task){
+      const unsigned int r = static_cast<unsigned int>(task/(new_chunks - chunks));
+      const std::size_t c = chunks + task % (new_chunks - chunks);
+      chunk_statistics[r][c] = chunk(r, c);
+    });
+    chunks = new_chunks;
+
+    std::vector<Statistics<field>> replicate_statistics(replicates);
+    for (unsigned int r = 0; r < replicates; ++r) {replicate_statistics[r] = pairwise_merge(chunk_statistics[r], 0, chunks);}
+
+    const double count = replicate_statistics[0].count;
+
+    if (replicates == 1) {
+      result = replicate_statistics[0].mean;
+      standard_error = (count > 1) ? std::sqrt(replicate_statistics[0].squares/(count - 1)/count) : std::numeric_limits<double>::infinity();
+    }
+    else {
+      Statistics<field> means;
+      for (const Statistics<field> &statistics : replicate_statistics) {means = merged(means, Statistics<field>{1, statistics.mean});}
+      result = means.mean;
+      standard_error = std::sqrt(means.squares/(replicates - 1)/replicates);
+    }
+
+    result *= volume;
+    standard_error *= std::abs(volume);
+    evaluations = static_cast<std::size_t>(count)*replicates;
+
+    running_samples.push_back(static_cast<std::size_t>(count));
+    running_errors.push_back(standard_error);
+
+    converged = (target_error <= 0 || standard_error <= target_error);
+    if (converged) {break;}
+  }
+
+  return result;
+}
+
+
+
+template class Monte_Carlo<double>;
+template class Monte_Carlo<std::complex<double>>;
+
+template class Quasi_Monte_Carlo<double>;
+template class Quasi_Monte_Carlo<std::complex<double>>;
@@ -0,0 +1,219 @@
+#include "../../Includes/Integration/Multi_Integration.hpp"
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+
+
+namespace {
+
+  // A one-dimensional rule with its nodes and weights (the scale of the composite rule is already in the weights).
+
+  struct Rule_1D {
+    std::vector<double> x;
+    std::vector<double> w;
+  };
+
+
+  template <typename Nodes>
+  Rule_1D materialize(const Nodes &nodes) {
+    Rule_1D result;
+    result.x.resize(nodes.count());
+    result.w.resize(nodes.count());
+    nodes.fill(0, nodes.count(), result.x.data(), result.w.data());
+    for (double &w : result.w) {w *= nodes.scale();}
+    return result;
+  }
+
+
+  Rule_1D rule_1d(const std::string &rule, const double &begin, const double &end, const std::size_t &subdivision_n, const unsigned int &number_of_nodes) {
+    const double h = (end - begin)/subdivision_n;
+    if (rule == "Midpoint") {return materialize(Midpoint_Nodes{begin, end, h, subdivision_n});}
+    if (rule == "Trapezoidal") {return materialize(Trapezoidal_Nodes{begin, end, h, subdivision_n});}
+    if (rule == "Simpson") {return materialize(Simpson_Nodes{begin, end, h, subdivision_n});}
+    if (rule == "Gaussian") {return materialize(Gaussian_Nodes{begin, end, h, subdivision_n, reference_gauss_rule("Legendre", number_of_nodes)});}
+    throw std::runtime_error("Invalid integration rule.");
+  }
+
+
+  // The i-th rule (i >= 1) of the sequence used by the Smolyak grids (see the header).
+
+  Rule_1D sequence_rule(const std::string &rule, const double &begin, const double &end, const std::size_t &subdivision_n, const unsigned int &i) {
+    if (rule == "Gaussian") {return rule_1d(rule, begin, end, subdivision_n, 2*i - 1);}
+    return rule_1d(rule, begin, end, subdivision_n << (i - 1), 0);
+  }
+
+
+
+  template <typename field, std::size_t D, typename F>
+  inline void evaluate_multi_points(F &f, const std::array<double, D>* x, const std::size_t &n, field* out) {
+    if constexpr (std::is_invocable_v<F&, const std::array<double, D>*, std::size_t, field*>) {f(x, n, out);}
+    else {for (std::size_t i = 0; i < n; ++i) {out[i] = f(x[i]);}}
+  }
+
+
+
+  /* The sum over the tensor product of the D one-dimensional rules. The points are numbered with the last
+  direction running fastest and split in chunks of kernel_chunk_size points, whose sums are added pairwise, as in
+  reduce_weighted_sum() (see Integration_Kernels.hpp): hence the result does not depend on the number of threads.
+  Inside a chunk, the points are generated in blocks of block_size points and the integrand is called once for
+  each block (if it is a batch integrand). */
+
+  template <typename field, std::size_t D, typename F>
+  field tensor_sum(const std::array<const Rule_1D*, D> &rules, F &f, const unsigned int &num_threads, std::size_t &evaluations) {
+
+    std::size_t count = 1;
+    for (const Rule_1D* rule : rules) {
+      if (count != 0 && rule->x.size() > std::numeric_limits<std::size_t>::max()/count) {throw std::runtime_error("Too many points in the grid.");}
+      count *= rule->x.size();
+    }
+
+    const std::size_t chunks = (count + kernel_chunk_size - 1)/kernel_chunk_size;
+    std::vector<field> partial_sums(chunks);
+
+    global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+
+      const std::size_t first = c*kernel_chunk_size;
+      const std::size_t last = std::min(count, first + kernel_chunk_size);
+      const std::size_t block = std::min(kernel_block_size, last - first);
+
+      std::vector<std::array<double, D>> x(block);
+      std::vector<double> w(block);
+      std::vector<field> y(block);
+
+      std::array<std::size_t, D> index; // The index of the current point along each direction
+      std::size_t linear_index = first;
+      for (std::size_t d = D; d-- > 0;) {
+        index[d] = linear_index % rules[d]->x.size();
+        linear_index /= rules[d]->x.size();
+      }
+
+      field sum{};
+
+      for (std::size_t j = first; j < last; j += block) {
+
+        const std::size_t n = std::min(block, last - j);
+
+        for (std::size_t k = 0; k < n; ++k) {
+          w[k] = 1.0;
+          for (std::size_t d = 0; d < D; ++d) {
+            x[k][d] = rules[d]->x[index[d]];
+            w[k] *= rules[d]->w[index[d]];
+          }
+          for (std::size_t d = D; d-- > 0;) { // Next point
+            if (++index[d] < rules[d]->x.size()) {break;}
+            index[d] = 0;
+          }
+        }
+
+        evaluate_multi_points<field, D>(f, x.data(), n, y.data());
+
+        for (std::size_t k = 0; k < n; ++k) {sum += w[k]*y[k];}
+      }
+
+      partial_sums[c] = sum;
+    });
+
+    evaluations += count;
+
+    return pairwise_sum(partial_sums, 0, chunks);
+  }
+
+
+
+  double binomial(const unsigned int &n, const unsigned int &k) {
+    double result = 1;
+    for (unsigned int j = 1; j <= k; ++j) {result = result*(n - k + j)/j;}
+    return result;
+  }
+
+
+  // Calls visit(i) for all the multi-indices i (with i_k >= 1) such that minimum <= |i| <= maximum.
+
+  template <std::size_t D, typename Visitor>
+  void for_each_multi_index(std::array<unsigned int, D> &i, const std::size_t &d, const unsigned int &sum, const unsigned int &minimum, const unsigned int &maximum, Visitor &visit) {
+    if (d == D) {
+      if (sum >= minimum) {visit(i);}
+      return;
+    }
+    const unsigned int remaining = static_cast<unsigned int>(D - d - 1); // Each one of the next indices is at least 1
+    for (i[d] = 1; sum + i[d] + remaining <= maximum; ++i[d]) {for_each_multi_index<D>(i, d + 1, sum + i[d], minimum, maximum, visit);}
+  }
+
+
+
+  template <typename field, std::size_t D, typename F>
+  field integrate_grid(Multi_Integration<field, D> &integrator, F f) {
+
+    integrator.evaluations = 0;
+
+    if (integrator.grid == "Tensor") {
+      std::array<Rule_1D, D> rules;
+      std::array<const Rule_1D*, D> pointers;
+      for (std::size_t d = 0; d < D; ++d) {
+        rules[d] = rule_1d(integrator.rule, integrator.begin[d], integrator.end[d], integrator.subdivision_n, integrator.number_of_nodes);
+        pointers[d] = &rules[d];
+      }
+      return tensor_sum<field, D>(pointers, f, integrator.num_threads, integrator.evaluations);
+    }
+
+    if (integrator.grid != "Smolyak") {throw std::runtime_error("Invalid grid: it must be 'Tensor' or 'Smolyak'.");}
+
+    // The one-dimensional rules used along each direction, sequence[d][i-1] being U_i.
+
+    const unsigned int level = integrator.level;
+    std::array<std::vector<Rule_1D>, D> sequence;
+    for (std::size_t d = 0; d < D; ++d) {
+      for (unsigned int i = 1; i <= level + 1; ++i) {sequence[d].push_back(sequence_rule(integrator.rule, integrator.begin[d], integrator.end[d], integrator.subdivision_n, i));}
+    }
+
+    field result{};
+    std::array<unsigned int, D> i;
+    const unsigned int maximum = level + static_cast<unsigned int>(D);
+
+    auto add_tensor_grid = [&](const std::array<unsigned int, D> &multi_index){
+      unsigned int norm = 0;
+      std::array<const Rule_1D*, D> rules;
+      for (std::size_t d = 0; d < D; ++d) {
+        norm += multi_index[d];
+        rules[d] = &sequence[d][multi_index[d] - 1];
+      }
+      const double coefficient = (((maximum - norm) % 2 == 0) ? 1.0 : -1.0)*binomial(static_cast<unsigned int>(D - 1), maximum - norm);
+      result += coefficient*tensor_sum<field, D>(rules, f, integrator.num_threads, integrator.evaluations);
+    };
+
+    for_each_multi_index<D>(i, 0, 0, level + 1, maximum, add_tensor_grid);
+
+    return result;
+  }
+
+}
+
+
+
+template <typename field, std::size_t D>
+field Multi_Integration<field, D>::compute_integral() {
+  if (subdivision_n == 0) {throw std::runtime_error("The number of subintervals must be positive.");}
+  if (batch_integrand) {return integrate_grid(*this, std::cref(batch_integrand));}
+  return integrate_grid(*this, std::cref(integrand));
+}
+
+
+
+template class Multi_Integration<double, 1>;
+template class Multi_Integration<double, 2>;
+template class Multi_Integration<double, 3>;
+template class Multi_Integration<double, 4>;
+template class Multi_Integration<double, 5>;
+template class Multi_Integration<double, 6>;
+template class Multi_Integration<double, 7>;
+template class Multi_Integration<double, 8>;
+
+template class Multi_Integration<std::complex<double>, 1>;
+template class Multi_Integration<std::complex<double>, 2>;
+template class Multi_Integration<std::complex<double>, 3>;
+template class Multi_Integration<std::complex<double>, 4>;
+template class Multi_Integration<std::complex<double>, 5>;
+template class Multi_Integration<std::complex<double>, 6>;
+template class Multi_Integration<std::complex<double>, 7>;
+template class Multi_Integration<std::complex<double>, 8>;
@@ -1,179 +1,766 @@
 #include "../../Includes/Integration/Numerical_Integration.hpp"
+#include "../../Includes/Integration/Gauss_Tables.hpp"
+#include <algorithm>
+#include <array>
+#include <queue>
+#include <limits>
 
 
-/* Except for gaussian integration (for which we have used gsl), the other formulas which are implemented
-follow the same scheme.
-The result can be obtained as sum of the values of the functions in some specific points, weighted with the
-appropriates weights.
-Hence we always created a vector called "values" which contained the values (already correctly weighted)
-of the functions in the correct points.
-The the result is just obtained by summing over the vector and multiplying by the stepsize. */
+/* All the formulas follow the same scheme: the result can be obtained as sum of the values of the function in
+some specific points, weighted with the appropriate weights.
+The loops computing these sums are implemented in Integration_Kernels.hpp, templatized on the type of the
+integrand, so here we just call them with the integrand saved in the object. If a batch integrand was given it is
+used instead of the usual one, so that the points are passed to it in blocks.
+
+The integrand is passed through std::cref in order to avoid copying the function wrapper each time, and the
+number of threads chosen by the user is passed to the kernel by the following function. */
+
+
+namespace {
+
+  template <typename Integrator>
+  auto run_with_threads(Integrator integrator, const unsigned int &num_threads) {
+    integrator.num_threads = num_threads;
+    return integrator.compute_integral();
+  }
+
+}
+
 
 
 template <typename field> 
 field Midpoint<field>::compute_integral() {
+  if (this->batch_integrand) {return run_with_threads(make_midpoint<field>(this->begin, this->end, this->subdivision_n, std::cref(this->batch_integrand)), this->num_threads);}
+  return run_with_threads(make_midpoint<field>(this->begin, this->end, this->subdivision_n, std::cref(this->integrand)), this->num_threads);
+}
+
+
+
+template <typename field>
+field Trapezoidal<field>::compute_integral() {
+  if (this->batch_integrand) {return run_with_threads(make_trapezoidal<field>(this->begin, this->end, this->subdivision_n, std::cref(this->batch_integrand)), this->num_threads);}
+  return run_with_threads(make_trapezoidal<field>(this->begin, this->end, this->subdivision_n, std::cref(this->integrand)), this->num_threads);
+}
+
+
+
+template <typename field>
+field Simpson<field>::compute_integral() {
+  if (this->batch_integrand) {return run_with_threads(make_simpson<field>(this->begin, this->end, this->subdivision_n, std::cref(this->batch_integrand)), this->num_threads);}
+  return run_with_threads(make_simpson<field>(this->begin, this->end, this->subdivision_n, std::cref(this->integrand)), this->num_threads);
+}
+
+
+
+/* For Gaussian integration, the nodes and the weights on the reference interval [-1, 1] are taken from the cache
+defined in Gauss_Nodes.hpp (which throws an exception if the family of polynomials is not valid) and mapped on
+each subinterval through the affine map t -> (x_(i-1)+x_i)/2 + t*(x_i-x_(i-1))/2, so that no workspace needs to
+be allocated during the integration.
+
+As before, the Legendre rule is used in its composite version, while the other families (whose weight function
+depends on the endpoints of the interval) are applied on the whole interval [begin, end].
+
+Complex integrands follow the same path: the integrand is evaluated once in each node and the real weights
+multiply the complex values directly, so there is no need to integrate the real and the imaginary part separately
+(which evaluated each node twice). */
+
+
+template <typename field>
+field Gaussian<field>::compute_integral() {
+  if (this->batch_integrand) {return run_with_threads(make_gaussian<field>(this->begin, this->end, this->subdivision_n, std::cref(this->batch_integrand), this->number_of_nodes, this->family_of_polynomials, this->alpha, this->beta), this->num_threads);}
+  return run_with_threads(make_gaussian<field>(this->begin, this->end, this->subdivision_n, std::cref(this->integrand), this->number_of_nodes, this->family_of_polynomials, this->alpha, this->beta), this->num_threads);
+}
+
+
+
+/* Error estimates of the composite rules (see Integration_Result in the header). The two sums are computed by
+reduce_embedded_sum(), so the value is the one of compute_integral() and no point is evaluated twice. */
 
-  std::vector<field> values;
-  for (unsigned int i = 1; i < this->partition.size(); ++i) {
 
-    double due = 2; // STL does not allow to divide a complex number by an integer.
-    double midpoint = (this->partition[i]+this->partition[i-1])/due;
+namespace {
 
-    values.push_back(this->integrand(midpoint));
+  template <typename field, typename Nodes, typename F>
+  Integration_Result<field> embedded_result(const Nodes &nodes, F integrand, const unsigned int &num_threads, const double &richardson_divisor, const bool &has_coarser_rule) {
+    const std::array<field, 2> sums = reduce_embedded_sum<field>(nodes, integrand, num_threads);
+    const double error_estimate = has_coarser_rule ? std::abs(sums[0] - sums[1])*std::abs(nodes.scale())/richardson_divisor : std::numeric_limits<double>::infinity();
+    return {scaled(sums[0], nodes.scale()), error_estimate, nodes.count()};
   }
-  field zero = 0.0; // This is needed in accumulate: summing inhomogeneous data types might not be allowed.
 
-  field result = std::accumulate(values.begin(), values.end(), zero);
+}
+
+
 
-  return result*this->h;
+template <typename field>
+Integration_Result<field> Midpoint<field>::compute_with_error() {
+  const Midpoint_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return embedded_result<field>(nodes, std::cref(this->batch_integrand), this->num_threads, 8, this->subdivision_n >= 3);}
+  return embedded_result<field>(nodes, std::cref(this->integrand), this->num_threads, 8, this->subdivision_n >= 3);
 }
 
 
 
 template <typename field>
-field Trapezoidal<field>::compute_integral() {
+Integration_Result<field> Trapezoidal<field>::compute_with_error() {
+  const Trapezoidal_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return embedded_result<field>(nodes, std::cref(this->batch_integrand), this->num_threads, 3, this->subdivision_n >= 2);}
+  return embedded_result<field>(nodes, std::cref(this->integrand), this->num_threads, 3, this->subdivision_n >= 2);
+}
 
-  std::vector<field> values;
-  for (unsigned int i = 1; i < this->partition.size(); ++i) {
 
-    field a = this->integrand(this->partition[i]);
-    field b = this->integrand(this->partition[i-1]);
 
-    values.push_back((a + b)/2.0);
+template <typename field>
+Integration_Result<field> Simpson<field>::compute_with_error() {
+  const Simpson_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return embedded_result<field>(nodes, std::cref(this->batch_integrand), this->num_threads, 15, this->subdivision_n >= 2);}
+  return embedded_result<field>(nodes, std::cref(this->integrand), this->num_threads, 15, this->subdivision_n >= 2);
+}
+
+
+
+/* A Gaussian rule with m nodes has no nodes in common with the one with m-1 nodes (except the center), so the
+pair of Gaussian rules needs about twice the evaluations of compute_integral(). The value is computed exactly as
+there, so it is the same. */
+
+
+namespace {
+
+  template <typename field, typename F>
+  Integration_Result<field> gaussian_pair_result(const Gaussian<field> &integrator, F integrand) {
+
+    const auto finer = make_gaussian<field>(integrator.begin, integrator.end, integrator.subdivision_n, integrand, integrator.number_of_nodes, integrator.family_of_polynomials, integrator.alpha, integrator.beta);
+    const field value = run_with_threads(finer, integrator.num_threads);
+
+    if (integrator.number_of_nodes < 2) {return {value, std::numeric_limits<double>::infinity(), finer.nodes().count()};}
+
+    const auto coarser = make_gaussian<field>(integrator.begin, integrator.end, integrator.subdivision_n, integrand, integrator.number_of_nodes - 1, integrator.family_of_polynomials, integrator.alpha, integrator.beta);
+    const field coarser_value = run_with_threads(coarser, integrator.num_threads);
+
+    return {value, std::abs(value - coarser_value), finer.nodes().count() + coarser.nodes().count()};
   }
 
-  field zero = 0.0;
-  field result = std::accumulate(values.begin(), values.end(),zero);
+}
+
+
+
+template <typename field>
+Integration_Result<field> Gaussian<field>::compute_with_error() {
+  if (this->batch_integrand) {return gaussian_pair_result<field>(*this, std::cref(this->batch_integrand));}
+  return gaussian_pair_result<field>(*this, std::cref(this->integrand));
+}
+
+
+
+/* Cumulative integrals (see reduce_cumulative_sum() in Integration_Kernels.hpp). As for the error estimates, the
+nodes are the ones used by compute_integral(). */
+
+
+namespace {
+
+  template <typename field, typename Nodes, typename F>
+  std::vector<field> cumulative_sums(const Nodes &nodes, F integrand, const unsigned int &num_threads) {
+    return reduce_cumulative_sum<field>(nodes, integrand, num_threads);
+  }
 
-  return result*this->h;
 }
 
 
 
 template <typename field>
-field Simpson<field>::compute_integral() {
+std::vector<field> Midpoint<field>::compute_cumulative() {
+  const Midpoint_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return cumulative_sums<field>(nodes, std::cref(this->batch_integrand), this->num_threads);}
+  return cumulative_sums<field>(nodes, std::cref(this->integrand), this->num_threads);
+}
 
-  std::vector<field> values;
-  for (unsigned int i = 1; i < this->partition.size(); ++i) {
 
-    double midpoint = (this->partition[i]+this->partition[i-1])/2;
 
-    field a = this->integrand(this->partition[i]);
-    field b = this->integrand(this->partition[i-1]);
-    field mid = this->integrand(midpoint);
+template <typename field>
+std::vector<field> Trapezoidal<field>::compute_cumulative() {
+  const Trapezoidal_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return cumulative_sums<field>(nodes, std::cref(this->batch_integrand), this->num_threads);}
+  return cumulative_sums<field>(nodes, std::cref(this->integrand), this->num_threads);
+}
+
+
+
+template <typename field>
+std::vector<field> Simpson<field>::compute_cumulative() {
+  const Simpson_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n};
+  if (this->batch_integrand) {return cumulative_sums<field>(nodes, std::cref(this->batch_integrand), this->num_threads);}
+  return cumulative_sums<field>(nodes, std::cref(this->integrand), this->num_threads);
+}
+
+
+
+template <typename field>
+std::vector<field> Gaussian<field>::compute_cumulative() {
+  if (this->family_of_polynomials != "Legendre") {throw std::runtime_error("compute_cumulative() is only available for the Legendre family, whose rule is composite.");}
+  const Gaussian_Nodes nodes{this->begin, this->end, this->h, this->subdivision_n, reference_gauss_rule("Legendre", this->number_of_nodes)};
+  if (this->batch_integrand) {return cumulative_sums<field>(nodes, std::cref(this->batch_integrand), this->num_threads);}
+  return cumulative_sums<field>(nodes, std::cref(this->integrand), this->num_threads);
+}
+
+
+
+/* Adaptive integration (see the header). The 15 points of the Gauss-Kronrod rule on [left, right] are
+center - half*t_k, center and center + half*t_k, where t_k are the nodes of Gauss_Tables.hpp: we store them from
+left to right, so that x[k] and x[14-k] are symmetric. The integrand is evaluated in all of them at once. */
+
+
+namespace {
 
-    values.push_back(a/6.0+b/6.0+2.0*mid/3.0);
+  template <typename field>
+  struct Adaptive_Segment {
+    double left;
+    double right;
+    field value;
+    double error;
+
+    bool operator<(const Adaptive_Segment &other) const {return error < other.error;} // For the priority queue
+  };
+
+
+
+  template <typename field>
+  Adaptive_Segment<field> kronrod_segment(const Integration<field> &integrator, const double &left, const double &right) {
+
+    const double center = (left + right)/2;
+    const double half = (right - left)/2;
+
+    std::array<double, 15> x;
+    std::array<field, 15> y;
+
+    for (unsigned int k = 0; k < kronrod_table_half_nodes; ++k) {
+      x[k] = center - half*kronrod15_nodes[k];
+      x[14-k] = center + half*kronrod15_nodes[k];
+    }
+
+    integrator.evaluate(x.data(), x.size(), y.data());
+
+    field kronrod = kronrod15_weights[7]*y[7];
+    field gauss = gauss7_weights[3]*y[7];
+
+    for (unsigned int k = 0; k < 7; ++k) {
+      kronrod += kronrod15_weights[k]*(y[k] + y[14-k]);
+      if (k % 2 == 1) {gauss += gauss7_weights[k/2]*(y[k] + y[14-k]);}
+    }
+
+    return Adaptive_Segment<field>{left, right, kronrod*half, std::abs((kronrod - gauss)*half)};
   }
 
-  field zero = 0.0;
-  field result = std::accumulate(values.begin(), values.end(), zero);
+}
+
 
-  return result*this->h;
+
+template <typename field>
+field Adaptive<field>::compute_integral() {
+
+  if (this->subdivision_n == 0) {throw std::runtime_error("The number of subintervals must be positive.");}
+  std::priority_queue<Adaptive_Segment<field>> segments;
+  double total_error = 0;
+
+  for (std::size_t i = 0; i < this->subdivision_n; ++i) {
+    Adaptive_Segment<field> segment = kronrod_segment(*this, this->partition[i], this->partition[i+1]);
+    total_error += segment.error;
+    segments.push(segment);
+  }
+
+  evaluations = 15*static_cast<std::size_t>(this->subdivision_n);
+
+  while (total_error > tolerance && segments.size() < max_subintervals) {
+
+    const Adaptive_Segment<field> worst = segments.top();
+    const double middle = (worst.left + worst.right)/2;
+
+    if (!(worst.left < middle && middle < worst.right)) {break;} // It cannot be bisected any more in double precision
+
+    segments.pop();
+
+    Adaptive_Segment<field> first_half = kronrod_segment(*this, worst.left, middle);
+    Adaptive_Segment<field> second_half = kronrod_segment(*this, middle, worst.right);
+    evaluations += 30;
+
+    total_error += first_half.error + second_half.error - worst.error;
+    segments.push(first_half);
+    segments.push(second_half);
+  }
+
+  // We sum again the values and the errors, in order not to keep the rounding errors of the updates above.
+
+  field result = 0.0;
+  error_estimate = 0;
+
+  while (!segments.empty()) {
+    result += segments.top().value;
+    error_estimate += segments.top().error;
+    segments.pop();
+  }
+
+  converged = (error_estimate <= tolerance);
+
+  return result;
 }
 
 
 
-/* For Gaussian integration, we just followed the gsl documentation.
-We inserted some if-checks to be sure that the family of polynomials is correct and to consequently use the
-correct weight function and parameters. */
+template <typename field>
+Integration_Result<field> Adaptive<field>::compute_with_error() {
+  const field value = compute_integral();
+  return {value, error_estimate, evaluations};
+}
+
+
+
+/* Romberg integration (see the header). The sums are computed by the kernels of Integration_Kernels.hpp, so
+they can run in parallel as for the other rules; we only keep the last row of the Richardson tableau. */
+
+
+namespace {
+
+  template <typename field, typename F>
+  field romberg_extrapolation(Romberg<field> &integrator, F integrand) {
+
+    std::size_t n = integrator.subdivision_n;
+    double h = integrator.h;
+
+    const Trapezoidal_Nodes trapezoidal{integrator.begin, integrator.end, h, n};
+    std::vector<field> previous{reduce_weighted_sum<field>(trapezoidal, integrand, integrator.num_threads)*trapezoidal.scale()};
+
+    integrator.evaluations = trapezoidal.count();
+    integrator.error_estimate = std::numeric_limits<double>::infinity();
+    integrator.converged = false;
+    integrator.levels = 1;
+
+    for (unsigned int level = 1; level < integrator.max_levels; ++level) {
+
+      const Midpoint_Nodes midpoints{integrator.begin, integrator.end, h, n};
+      const field midpoint_rule = reduce_weighted_sum<field>(midpoints, integrand, integrator.num_threads)*midpoints.scale();
+
+      integrator.evaluations += midpoints.count();
+      integrator.levels = level + 1;
+      n *= 2;
+      h /= 2;
+
+      std::vector<field> current(level + 1);
+      current[0] = (previous[0] + midpoint_rule)/2.0;
+
+      double power_of_4 = 1;
+      for (unsigned int j = 1; j <= level; ++j) {
+        power_of_4 *= 4;
+        current[j] = current[j-1] + (current[j-1] - previous[j-1])/(power_of_4 - 1);
+      }
+
+      integrator.error_estimate = std::abs(current[level] - previous[level-1]);
+      previous.swap(current);
+
+      if (level >= 2 && integrator.error_estimate <= integrator.tolerance) {
+        integrator.converged = true;
+        break;
+      }
+    }
+
+    return previous.back();
+  }
+
+}
+
 
 
 template <typename field>
-field Gaussian<field>::compute_integral() {
+field Romberg<field>::compute_integral() {
+  if (this->batch_integrand) {return romberg_extrapolation(*this, std::cref(this->batch_integrand));}
+  return romberg_extrapolation(*this, std::cref(this->integrand));
+}
+
+
+
+template <typename field>
+Integration_Result<field> Romberg<field>::compute_with_error() {
+  const field value = compute_integral();
+  return {value, error_estimate, evaluations};
+}
+
+
+
+/* Clenshaw-Curtis integration (see the header). values contains the values of the integrand in the nodes of the
+current level, subinterval after subinterval: the one in the node j of the subinterval i is values[i*(n+1) + j]. */
 
-  field result;
-  gsl_function to_be_integrated;
-  to_be_integrated.function = static_tmp_fct;
-  to_be_integrated.params = static_cast<void*>(this);
 
-  if (this->family_of_polynomials == "Legendre") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_legendre;
-    std::vector<field> subinterval_integration;
+namespace {
 
-    // Just to avoid a warning
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, 0.0, 0.0);
+  // Evaluates the integrand in all the points of x, distributing the chunks of points among the threads.
 
-    for (size_t i = 1; i < this->partition.size(); ++i) {
-      w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->partition[i-1], this->partition[i], 0.0, 0.0);
-      gsl_integration_fixed(&to_be_integrated, &result, w);
-      subinterval_integration.push_back(result);
+  template <typename field>
+  void evaluate_all(const Integration<field> &integrator, const std::vector<double> &x, std::vector<field> &y) {
+    const std::size_t chunks = (x.size() + kernel_chunk_size - 1)/kernel_chunk_size;
+    global_thread_pool().parallel_for(chunks, resolve_num_threads(integrator.num_threads), [&](std::size_t c){
+      const std::size_t last = std::min(x.size(), (c + 1)*kernel_chunk_size);
+      for (std::size_t j = c*kernel_chunk_size; j < last; j += integrator.block_size) {
+        integrator.evaluate(x.data() + j, std::min(integrator.block_size, last - j), y.data() + j);
+      }
+    });
+  }
+
+}
+
+
+
+template <typename field>
+field Clenshaw_Curtis<field>::compute_integral() {
+
+  if (max_level > max_clenshaw_curtis_level) {throw std::runtime_error("The maximum level of the Clenshaw-Curtis rule is too large.");}
+  if (this->subdivision_n == 0) {throw std::runtime_error("The number of subintervals must be positive.");}
+
+  const std::size_t m = this->subdivision_n;
+  const double half_h = this->h/2;
+
+  std::vector<field> values;
+  std::size_t n = 0; // 2^level, the number of intervals between the nodes of the current level
+  field previous{};
+  field current{};
+
+  evaluations = 0;
+  error_estimate = std::numeric_limits<double>::infinity();
+  converged = false;
+
+  for (level = 0; level <= max_level; ++level) {
+
+    const std::shared_ptr<const Gauss_Rule> rule = reference_clenshaw_curtis_rule(level);
+    const std::size_t new_n = std::size_t(1) << level;
+    const std::size_t new_per_subinterval = (level == 0) ? 2 : n; // At level 0 both the nodes are new, then the ones with odd j
+
+    std::vector<double> x(m*new_per_subinterval);
+    for (std::size_t i = 0; i < m; ++i) {
+      const double center = this->begin + (static_cast<double>(i) + 0.5)*this->h;
+      for (std::size_t k = 0; k < new_per_subinterval; ++k) {
+        const std::size_t j = (level == 0) ? k : 2*k + 1;
+        x[i*new_per_subinterval + k] = center + half_h*rule->nodes[j];
+      }
+    }
+
+    std::vector<field> y(x.size());
+    evaluate_all(*this, x, y);
+    evaluations += x.size();
+
+    std::vector<field> merged(m*(new_n + 1));
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j <= new_n; ++j) {
+        if (level == 0) {merged[i*(new_n + 1) + j] = y[i*2 + j];}
+        else if (j % 2 == 0) {merged[i*(new_n + 1) + j] = values[i*(n + 1) + j/2];}
+        else {merged[i*(new_n + 1) + j] = y[i*n + j/2];}
+      }
     }
+    values.swap(merged);
+    n = new_n;
+
+    std::vector<field> sums(m);
+    for (std::size_t i = 0; i < m; ++i) {
+      field sum{};
+      for (std::size_t j = 0; j <= n; ++j) {sum += rule->weights[j]*values[i*(n + 1) + j];}
+      sums[i] = sum;
+    }
+
+    previous = current;
+    current = pairwise_sum(sums, 0, m)*half_h;
 
-    result = std::accumulate(subinterval_integration.begin(), subinterval_integration.end(), 0.0);
-    gsl_integration_fixed_free (w);
+    if (level > 0) {error_estimate = std::abs(current - previous);}
+    if (level >= 2 && error_estimate <= tolerance) {
+      converged = true;
+      break;
+    }
   }
 
+  level = std::min(level, max_level);
 
-  else if (family_of_polynomials == "Chebyshev Type 1") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_chebyshev;
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, 0.0, 0.0);
-    gsl_integration_fixed(&to_be_integrated, &result, w);
-    gsl_integration_fixed_free (w);
+  return current;
+}
+
+
+
+template <typename field>
+Integration_Result<field> Clenshaw_Curtis<field>::compute_with_error() {
+  const field value = compute_integral();
+  return {value, error_estimate, evaluations};
+}
+
+
+
+/* Double exponential integration (see the header). sum contains the sum of w*f(x) over all the nodes of the
+previous levels, so that the result of a level is sum*step*h/2. */
+
+
+template <typename field>
+field Double_Exponential<field>::compute_integral() {
+
+  if (this->subdivision_n == 0) {throw std::runtime_error("The number of subintervals must be positive.");}
+  const std::size_t m = this->subdivision_n;
+  const double half_h = this->h/2;
+  const double pi = std::acos(-1.0);
+
+  field sum{};
+  field previous{};
+  field current{};
+
+  evaluations = 0;
+  error_estimate = std::numeric_limits<double>::infinity();
+  converged = false;
+
+  for (level = 0; level <= max_level; ++level) {
+
+    const std::shared_ptr<const Tanh_Sinh_Level> table = tanh_sinh_level(level);
+
+    std::vector<double> x;
+    std::vector<double> w;
+    x.reserve(m*(2*table->weights.size() + 1));
+    w.reserve(x.capacity());
+
+    for (std::size_t i = 0; i < m; ++i) {
+      const double left = this->begin + static_cast<double>(i)*this->h;
+      const double right = (i + 1 == m) ? this->end : this->begin + static_cast<double>(i + 1)*this->h;
+
+      if (level == 0) {
+        x.push_back(left + half_h);
+        w.push_back(pi/2);
+      }
+      for (std::size_t k = 0; k < table->weights.size(); ++k) {
+        const double distance = half_h*table->complements[k];
+        if (left + distance != left) {x.push_back(left + distance); w.push_back(table->weights[k]);}
+        if (right - distance != right) {x.push_back(right - distance); w.push_back(table->weights[k]);}
+      }
+    }
+
+    std::vector<field> y(x.size());
+    evaluate_all(*this, x, y);
+    evaluations += x.size();
+
+    field level_sum{};
+    for (std::size_t j = 0; j < x.size(); ++j) {level_sum += w[j]*y[j];}
+    sum += level_sum;
+
+    previous = current;
+    current = sum*(std::ldexp(1.0, -static_cast<int>(level))*half_h);
+
+    if (level > 0) {error_estimate = std::abs(current - previous);}
+    if (level >= 2 && error_estimate <= tolerance) {
+      converged = true;
+      break;
+    }
   }
 
+  level = std::min(level, max_level);
 
-  else if (family_of_polynomials == "Gegenbauer") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_gegenbauer;
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, this->alpha, 0.0);
-    gsl_integration_fixed(&to_be_integrated, &result, w);
-    gsl_integration_fixed_free (w);
+  return current;
+}
+
+
+
+template <typename field>
+Integration_Result<field> Double_Exponential<field>::compute_with_error() {
+  const field value = compute_integral();
+  return {value, error_estimate, evaluations};
+}
+
+
+
+/* Integration on many intervals (see the header). The sum on each interval is computed by the same kernel used
+by the integrators, serially, since the threads are already used for the intervals. */
+
+
+namespace {
+
+  // Throws if the rule is not one of the ones accepted by integrate_many() and convergence_study().
+
+  void check_rule(const std::string &rule) {
+    if (rule != "Midpoint" && rule != "Trapezoidal" && rule != "Simpson" && rule != "Gaussian") {throw std::runtime_error("Invalid integration rule.");}
   }
 
 
-  else if (family_of_polynomials == "Jacobi") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_jacobi;
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, this->alpha, this->beta);
-    gsl_integration_fixed(&to_be_integrated, &result, w);
-    gsl_integration_fixed_free (w);
+  // Integrates on [begin, end] with one thread, exactly as the integrator of the given rule would do.
+
+  template <typename field, typename F>
+  field integrate_with_rule(const std::string &rule, const double &begin, const double &end, const std::size_t &subdivision_n, F integrand, const std::shared_ptr<const Gauss_Rule> &gauss_rule) {
+    const double h = (end - begin)/subdivision_n;
+
+    if (rule == "Midpoint") {
+      const Midpoint_Nodes nodes{begin, end, h, subdivision_n};
+      return reduce_weighted_sum<field>(nodes, integrand, 1)*nodes.scale();
+    }
+    if (rule == "Trapezoidal") {
+      const Trapezoidal_Nodes nodes{begin, end, h, subdivision_n};
+      return reduce_weighted_sum<field>(nodes, integrand, 1)*nodes.scale();
+    }
+    if (rule == "Simpson") {
+      const Simpson_Nodes nodes{begin, end, h, subdivision_n};
+      return reduce_weighted_sum<field>(nodes, integrand, 1)*nodes.scale();
+    }
+    const Gaussian_Nodes nodes{begin, end, h, subdivision_n, gauss_rule};
+    return reduce_weighted_sum<field>(nodes, integrand, 1)*nodes.scale();
   }
 
 
-  else if (family_of_polynomials == "Exponential") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_exponential;
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, this->alpha, 0);
-    gsl_integration_fixed(&to_be_integrated, &result, w);
-    gsl_integration_fixed_free (w);
+  template <typename field, typename F>
+  std::vector<field> integrate_intervals(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const std::size_t &subdivision_n, F integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads) {
+
+    check_rule(rule);
+
+    std::shared_ptr<const Gauss_Rule> gauss_rule;
+    if (rule == "Gaussian") {gauss_rule = reference_gauss_rule("Legendre", number_of_nodes);}
+
+    std::vector<field> results(intervals.size());
+
+    auto integrate_interval = [&](std::size_t i){
+      results[i] = integrate_with_rule<field>(rule, intervals[i].first, intervals[i].second, subdivision_n, integrand, gauss_rule);
+    };
+
+    global_thread_pool().parallel_for(intervals.size(), resolve_num_threads(num_threads), integrate_interval);
+
+    return results;
+  }
+
+}
+
+
+
+template <typename field>
+std::vector<field> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<field(double)> integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads) {
+  return integrate_intervals<field>(intervals, rule, subdivision_n, std::cref(integrand), number_of_nodes, num_threads);
+}
+
+
+template <typename field>
+std::vector<field> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, Batch_Integrand<field> batch_integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads) {
+  return integrate_intervals<field>(intervals, rule, subdivision_n, std::cref(batch_integrand), number_of_nodes, num_threads);
+}
+
+
+
+
+// Convergence studies (see the header).
+
+
+template <typename field>
+Convergence_Study<field> convergence_study(const std::string &rule, std::function<field(double)> integrand, const field &exact, const std::vector<unsigned int> &subdivisions, const double &begin, const double &end, const unsigned int &number_of_nodes, const unsigned int &num_threads) {
+
+  check_rule(rule);
+
+  if (std::find(subdivisions.begin(), subdivisions.end(), 0u) != subdivisions.end()) {
+    throw std::runtime_error("The numbers of subintervals must be positive.");
   }
 
+  std::shared_ptr<const Gauss_Rule> gauss_rule;
+  if (rule == "Gaussian") {gauss_rule = reference_gauss_rule("Legendre", number_of_nodes);}
+
+  Convergence_Study<field> study;
+  study.subdivisions = subdivisions;
+  study.results.resize(subdivisions.size());
+  study.errors.resize(subdivisions.size());
+
+  global_thread_pool().parallel_for(subdivisions.size(), resolve_num_threads(num_threads), [&](std::size_t i){
+    study.results[i] = integrate_with_rule<field>(rule, begin, end, subdivisions[i], std::cref(integrand), gauss_rule);
+    study.errors[i] = std::abs(study.results[i] - exact);
+  });
 
-  else if (family_of_polynomials == "Chebyshev Type 2") {
-    gsl_integration_fixed_workspace  *w;
-    const gsl_integration_fixed_type * T = gsl_integration_fixed_chebyshev2;
-    w = gsl_integration_fixed_alloc(T, this->number_of_nodes, this->begin, this->end, this->alpha, 0);
-    gsl_integration_fixed(&to_be_integrated, &result, w);
-    gsl_integration_fixed_free (w);
+  /* Least-squares fit of log(error) = c - p*log(subdivision_n). The errors at the level of the rounding errors
+  would spoil the fit, so they are discarded. */
+
+  const double noise = 64*std::numeric_limits<double>::epsilon()*std::max(1.0, std::abs(exact));
+
+  double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+
+  for (std::size_t i = 0; i < subdivisions.size(); ++i) {
+    if (study.errors[i] <= noise) {continue;}
+    const double x = std::log(static_cast<double>(subdivisions[i]));
+    const double y = std::log(study.errors[i]);
+    sum_x += x; sum_y += y; sum_xx += x*x; sum_xy += x*y;
+    ++study.levels_used;
   }
 
+  const double n = study.levels_used;
+  const double denominator = n*sum_xx - sum_x*sum_x;
 
-  else {throw std::runtime_error("Invalid family of polynomials.");}
-    
-  return result;
+  if (study.levels_used >= 2 && denominator > 0) {study.convergence_order = -(n*sum_xy - sum_x*sum_y)/denominator;}
+
+  return study;
 }
 
 
 
-/* Now we specialize the method in order to be able to integrate complex functions.
-We just split them in real and imaginary part and compute the integral of each one of them. */
+unsigned int polynomial_order(const std::string &rule, const unsigned int &number_of_nodes, const unsigned int &max_degree) {
 
+  check_rule(rule);
 
-template<>
-std::complex<double> Gaussian<std::complex<double>>::compute_integral() {
+  std::shared_ptr<const Gauss_Rule> gauss_rule;
+  if (rule == "Gaussian") {gauss_rule = reference_gauss_rule("Legendre", number_of_nodes);}
 
-  Gaussian<double> Real{this->begin, this->end, this->subdivision_n, my_reality(this->integrand), this->number_of_nodes, this->family_of_polynomials};
-  double x_1 = Real.compute_integral();
+  for (unsigned int k = 0; k <= max_degree; ++k) {
+    const double result = integrate_with_rule<double>(rule, 0, 1, 1, [k](double x){return std::pow(x, k);}, gauss_rule);
+    if (std::abs(result - 1.0/(k+1)) >= 1e-8) {
+      if (k == 0) {throw std::runtime_error("The rule does not integrate even the constants exactly.");}
+      return k-1;
+    }
+  }
 
-  Gaussian<double> Immaginary{this->begin, this->end, this->subdivision_n, imagine_dragons(this->integrand), this->number_of_nodes, this->family_of_polynomials};
-  std::complex<double> result{x_1, Immaginary.compute_integral()};
+  return max_degree;
+}
 
-  return result;
+
+
+// Vector-valued integrands (see the header).
+
+
+namespace {
+
+  template <typename field, typename F>
+  std::vector<field> integrate_vector(const Vector_Integration<field> &integrator, F integrand) {
+
+    const double begin = integrator.begin;
+    const double end = integrator.end;
+    const double h = integrator.h;
+    const std::size_t n = integrator.subdivision_n;
+    const std::size_t K = integrator.number_of_outputs;
+
+    std::vector<field> result;
+    double scale;
+
+    if (integrator.rule == "Midpoint") {
+      const Midpoint_Nodes nodes{begin, end, h, n};
+      result = reduce_vector_weighted_sum<field>(nodes, integrand, K, integrator.num_threads);
+      scale = nodes.scale();
+    }
+    else if (integrator.rule == "Trapezoidal") {
+      const Trapezoidal_Nodes nodes{begin, end, h, n};
+      result = reduce_vector_weighted_sum<field>(nodes, integrand, K, integrator.num_threads);
+      scale = nodes.scale();
+    }
+    else if (integrator.rule == "Simpson") {
+      const Simpson_Nodes nodes{begin, end, h, n};
+      result = reduce_vector_weighted_sum<field>(nodes, integrand, K, integrator.num_threads);
+      scale = nodes.scale();
+    }
+    else if (integrator.rule == "Gaussian") {
+      const Gaussian_Nodes nodes{begin, end, h, n, reference_gauss_rule("Legendre", integrator.number_of_nodes)};
+      result = reduce_vector_weighted_sum<field>(nodes, integrand, K, integrator.num_threads);
+      scale = nodes.scale();
+    }
+    else {throw std::runtime_error("Invalid integration rule.");}
+
+    for (field &value : result) {value *= scale;}
+
+    return result;
+  }
+
+}
+
+
+
+template <typename field>
+std::vector<field> Vector_Integration<field>::compute_integral() const {
+  if (batch_integrand) {return integrate_vector(*this, std::cref(batch_integrand));}
+  return integrate_vector(*this, std::cref(integrand));
 }
 
 
+
 // This was the function for printing complex numbers in a readable way.
 
 template <typename field>
@@ -196,4 +783,27 @@ template class Trapezoidal<std::complex<double>>;
 template class Simpson<double>;
 template class Simpson<std::complex<double>>;
 
-template std::string nicer_complex(std::complex<double> number);
\ No newline at end of file
+template class Adaptive<double>;
+template class Adaptive<std::complex<double>>;
+
+template class Romberg<double>;
+template class Romberg<std::complex<double>>;
+
+template class Clenshaw_Curtis<double>;
+template class Clenshaw_Curtis<std::complex<double>>;
+
+template class Double_Exponential<double>;
+template class Double_Exponential<std::complex<double>>;
+
+template class Vector_Integration<double>;
+template class Vector_Integration<std::complex<double>>;
+
+template std::string nicer_complex(std::complex<double> number);
+
+template std::vector<double> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<double(double)> integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads);
+template std::vector<std::complex<double>> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, std::function<std::complex<double>(double)> integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads);
+template std::vector<double> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, Batch_Integrand<double> batch_integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads);
+template std::vector<std::complex<double>> integrate_many(const std::vector<std::pair<double, double>> &intervals, const std::string &rule, const unsigned int &subdivision_n, Batch_Integrand<std::complex<double>> batch_integrand, const unsigned int &number_of_nodes, const unsigned int &num_threads);
+
+template Convergence_Study<double> convergence_study(const std::string &rule, std::function<double(double)> integrand, const double &exact, const std::vector<unsigned int> &subdivisions, const double &begin, const double &end, const unsigned int &number_of_nodes, const unsigned int &num_threads);
+template Convergence_Study<std::complex<double>> convergence_study(const std::string &rule, std::function<std::complex<double>(double)> integrand, const std::complex<double> &exact, const std::vector<unsigned int> &subdivisions, const double &begin, const double &end, const unsigned int &number_of_nodes, const unsigned int &num_threads);
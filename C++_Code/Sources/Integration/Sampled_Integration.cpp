@@ -0,0 +1,182 @@
+#include "../../Includes/Integration/Sampled_Integration.hpp"
+#include <stdexcept>
+#include <string>
+
+
+
+namespace {
+
+  /* The sum of term(0), ..., term(count-1), split in chunks of kernel_chunk_size terms whose sums are added
+  pairwise, as in reduce_weighted_sum() (see Integration_Kernels.hpp). */
+
+  template <typename field, typename Term>
+  field chunked_sum(const std::size_t &count, const unsigned int &num_threads, const Term &term) {
+
+    auto chunk_sum = [&](const std::size_t &first, const std::size_t &last){
+      field sum{};
+      for (std::size_t i = first; i < last; ++i) {sum += term(i);}
+      return sum;
+    };
+
+    const std::size_t chunks = (count + kernel_chunk_size - 1)/kernel_chunk_size;
+
+    if (chunks <= 1) {return chunk_sum(0, count);}
+
+    std::vector<field> partial_sums(chunks);
+
+    global_thread_pool().parallel_for(chunks, resolve_num_threads(num_threads), [&](std::size_t c){
+      partial_sums[c] = chunk_sum(c*kernel_chunk_size, std::min(count, (c + 1)*kernel_chunk_size));
+    });
+
+    return pairwise_sum(partial_sums, 0, chunks);
+  }
+
+
+
+  template <typename field>
+  field trapezoidal_sum(const Sampled_Integration<field> &data) {
+    const field* y = data.y;
+    return chunked_sum<field>(data.n - 1, data.num_threads, [&](const std::size_t &i){return (data.spacing(i)/2)*(y[i] + y[i+1]);});
+  }
+
+
+
+  /* The integral of the parabola through the points i, i+1, i+2 on [x[i], x[i+2]], with h0 and h1 the lengths of
+  the two intervals (for h0 == h1 == h, the weights are h/3, 4h/3, h/3). */
+
+  template <typename field>
+  field simpson_pair(const Sampled_Integration<field> &data, const std::size_t &i) {
+    const double h0 = data.spacing(i);
+    const double h1 = data.spacing(i+1);
+    const double h = h0 + h1;
+    return (h/6)*((2 - h1/h0)*data.y[i] + (h*h/(h0*h1))*data.y[i+1] + (2 - h0/h1)*data.y[i+2]);
+  }
+
+
+  template <typename field>
+  field simpson_sum(const Sampled_Integration<field> &data) {
+
+    const std::size_t intervals = data.n - 1;
+    if (intervals == 1) {return trapezoidal_sum(data);}
+
+    field result = chunked_sum<field>(intervals/2, data.num_threads, [&](const std::size_t &k){return simpson_pair(data, 2*k);});
+
+    /* If the number of intervals is odd, the last one is integrated with the parabola through the last three
+    points (for equally spaced points, the weights are -h/12, 8h/12, 5h/12). */
+
+    if (intervals % 2 == 1) {
+      const std::size_t N = intervals;
+      const double h0 = data.spacing(N-2);
+      const double h1 = data.spacing(N-1);
+      const double alpha = (2*h1*h1 + 3*h0*h1)/(6*(h0 + h1));
+      const double beta = (h1*h1 + 3*h0*h1)/(6*h0);
+      const double eta = h1*h1*h1/(6*h0*(h0 + h1));
+      result += alpha*data.y[N] + beta*data.y[N-1] - eta*data.y[N-2];
+    }
+
+    return result;
+  }
+
+
+
+  /* The second derivatives M[0], ..., M[N] of the not-a-knot cubic spline (N >= 3 intervals). The equations of the
+  interior points are
+      h[i-1]*M[i-1] + 2*(h[i-1]+h[i])*M[i] + h[i]*M[i+1] = 6*((y[i+1]-y[i])/h[i] - (y[i]-y[i-1])/h[i-1]),
+  while the not-a-knot conditions (the third derivative is continuous in x[1] and x[N-1]) give M[0] as a function
+  of M[1], M[2] and M[N] as a function of M[N-1], M[N-2]. Substituting them in the first and in the last equation,
+  the system for M[1], ..., M[N-1] is tridiagonal and is solved with the Thomas algorithm. */
+
+  template <typename field>
+  std::vector<field> spline_second_derivatives(const Sampled_Integration<field> &data) {
+
+    const std::size_t N = data.n - 1;
+    const field* y = data.y;
+
+    std::vector<double> sub(N-1), diagonal(N-1), super(N-1);
+    std::vector<field> rhs(N-1);
+
+    for (std::size_t i = 1; i < N; ++i) {
+      const double h0 = data.spacing(i-1);
+      const double h1 = data.spacing(i);
+      sub[i-1] = h0;
+      diagonal[i-1] = 2*(h0 + h1);
+      super[i-1] = h1;
+      rhs[i-1] = 6.0*((y[i+1] - y[i])/h1 - (y[i] - y[i-1])/h0);
+    }
+
+    const double h_first = data.spacing(0), h_second = data.spacing(1);
+    diagonal[0] = (h_first + h_second)*(h_first + 2*h_second)/h_second;
+    super[0] = (h_second*h_second - h_first*h_first)/h_second;
+
+    const double h_before_last = data.spacing(N-2), h_last = data.spacing(N-1);
+    sub[N-2] = (h_before_last*h_before_last - h_last*h_last)/h_before_last;
+    diagonal[N-2] = (h_before_last + h_last)*(2*h_before_last + h_last)/h_before_last;
+
+    // Thomas algorithm: forward elimination, then back substitution.
+
+    for (std::size_t j = 1; j < N-1; ++j) {
+      const double factor = sub[j]/diagonal[j-1];
+      diagonal[j] -= factor*super[j-1];
+      rhs[j] -= factor*rhs[j-1];
+    }
+
+    std::vector<field> M(N+1);
+    M[N-1] = rhs[N-2]/diagonal[N-2];
+    for (std::size_t j = N-2; j-- > 0;) {M[j+1] = (rhs[j] - super[j]*M[j+2])/diagonal[j];}
+
+    M[0] = (1 + h_first/h_second)*M[1] - (h_first/h_second)*M[2];
+    M[N] = (1 + h_last/h_before_last)*M[N-1] - (h_last/h_before_last)*M[N-2];
+
+    return M;
+  }
+
+
+  template <typename field>
+  field spline_sum(const Sampled_Integration<field> &data) {
+
+    if (data.n <= 3) {return simpson_sum(data);}
+
+    const std::vector<field> M = spline_second_derivatives(data);
+    const field* y = data.y;
+
+    return chunked_sum<field>(data.n - 1, data.num_threads, [&](const std::size_t &i){
+      const double h = data.spacing(i);
+      return (h/2)*(y[i] + y[i+1]) - (h*h*h/24)*(M[i] + M[i+1]);
+    });
+  }
+
+}
+
+
+
+template <typename field>
+Sampled_Integration<field>::Sampled_Integration(const double* x, const field* y, const std::size_t &n, const std::string &rule) : x(x), y(y), n(n), rule(rule) {
+  if (n < 2) {throw std::runtime_error("At least two samples are needed.");}
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    if (!(x[i] < x[i+1])) {throw std::runtime_error("The points x must be strictly increasing (x[" + std::to_string(i+1) + "] <= x[" + std::to_string(i) + "]).");}
+  }
+}
+
+
+
+template <typename field>
+Sampled_Integration<field>::Sampled_Integration(const double &dx, const field* y, const std::size_t &n, const std::string &rule) : dx(dx), y(y), n(n), rule(rule) {
+  if (n < 2) {throw std::runtime_error("At least two samples are needed.");}
+  if (!(dx > 0)) {throw std::runtime_error("The spacing dx must be positive.");}
+}
+
+
+
+template <typename field>
+field Sampled_Integration<field>::compute_integral() const {
+  if (n < 2) {throw std::runtime_error("At least two samples are needed.");}
+  if (rule == "Trapezoidal") {return trapezoidal_sum(*this);}
+  if (rule == "Simpson") {return simpson_sum(*this);}
+  if (rule == "Spline") {return spline_sum(*this);}
+  throw std::runtime_error("Invalid rule: it must be 'Trapezoidal', 'Simpson' or 'Spline'.");
+}
+
+
+
+template class Sampled_Integration<double>;
+template class Sampled_Integration<std::complex<double>>;
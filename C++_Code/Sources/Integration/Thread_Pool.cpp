@@ -0,0 +1,171 @@
+#include "../../Includes/Integration/Thread_Pool.hpp"
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+
+
+namespace {
+
+  std::atomic<unsigned int> default_num_threads{1};
+
+
+  // True in the threads which are currently running a task of parallel_for() (see the comment in the header).
+
+  thread_local bool inside_parallel_for = false;
+
+
+
+  /* The state shared by the threads taking part in a parallel_for(). It is kept alive by a shared_ptr, since a
+  thread of the pool may look at it (finding that there is nothing left to do) after parallel_for() returned. */
+
+  struct Parallel_For_State {
+
+    Parallel_For_State(const std::size_t &number_of_tasks, const std::function<void(std::size_t)> &task) : number_of_tasks(number_of_tasks), task(&task) {}
+
+    const std::size_t number_of_tasks;
+    const std::function<void(std::size_t)>* task; // Only used while there are tasks left, i.e. before parallel_for() returns
+
+    std::atomic<std::size_t> next_task{0};
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable all_done;
+    std::size_t finished_tasks = 0; // Protected by the mutex
+    std::exception_ptr exception; // Protected by the mutex
+
+
+    // Runs tasks until there are none left.
+
+    void run() {
+
+      const bool was_inside = inside_parallel_for;
+      inside_parallel_for = true;
+
+      while (true) {
+
+        const std::size_t i = next_task.fetch_add(1);
+        if (i >= number_of_tasks) {break;}
+
+        std::exception_ptr error;
+        if (!failed.load()) {
+          try {(*task)(i);}
+          catch (...) {error = std::current_exception(); failed.store(true);}
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error && !exception) {exception = error;}
+        if (++finished_tasks == number_of_tasks) {all_done.notify_all();}
+      }
+
+      inside_parallel_for = was_inside;
+    }
+  };
+
+}
+
+
+
+Thread_Pool::Thread_Pool(const unsigned int &number_of_workers) {reserve(number_of_workers);}
+
+
+
+Thread_Pool::~Thread_Pool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  job_available.notify_all();
+  for (std::thread &worker : workers) {worker.join();}
+}
+
+
+
+void Thread_Pool::reserve(const unsigned int &number_of_workers) {
+  std::lock_guard<std::mutex> lock(mutex);
+  while (workers.size() < number_of_workers) {workers.emplace_back([this](){work();});}
+}
+
+
+
+unsigned int Thread_Pool::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return workers.size();
+}
+
+
+
+void Thread_Pool::enqueue(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  job_available.notify_one();
+}
+
+
+
+void Thread_Pool::work() {
+  while (true) {
+
+    std::function<void()> job;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      job_available.wait(lock, [this](){return stopping || !jobs.empty();});
+      if (jobs.empty()) {return;} // We only stop once all the submitted jobs have been run
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+
+    job();
+  }
+}
+
+
+
+void Thread_Pool::parallel_for(const std::size_t &number_of_tasks, const unsigned int &number_of_threads, const std::function<void(std::size_t)> &task) {
+
+  if (number_of_tasks == 0) {return;}
+
+  if (number_of_threads <= 1 || number_of_tasks == 1 || inside_parallel_for) {
+    for (std::size_t i = 0; i < number_of_tasks; ++i) {task(i);}
+    return;
+  }
+
+  // The calling thread is one of the threads, so we only need number_of_threads-1 helpers from the pool.
+
+  const unsigned int helpers = static_cast<unsigned int>(std::min<std::size_t>(number_of_threads, number_of_tasks)) - 1;
+  reserve(helpers);
+
+  auto state = std::make_shared<Parallel_For_State>(number_of_tasks, task);
+  for (unsigned int i = 0; i < helpers; ++i) {enqueue([state](){state->run();});}
+
+  state->run();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->all_done.wait(lock, [&state](){return state->finished_tasks == state->number_of_tasks;});
+
+  if (state->exception) {std::rethrow_exception(state->exception);}
+}
+
+
+
+Thread_Pool& global_thread_pool() {
+  static Thread_Pool pool;
+  return pool;
+}
+
+
+
+void set_default_num_threads(const unsigned int &num_threads) {default_num_threads.store(num_threads);}
+
+unsigned int get_default_num_threads() {return default_num_threads.load();}
+
+
+
+unsigned int resolve_num_threads(const unsigned int &num_threads) {
+  unsigned int result = (num_threads == 0) ? default_num_threads.load() : num_threads;
+  if (result == 0) {result = std::max(1u, std::thread::hardware_concurrency());}
+  return result;
+}
@@ -3,6 +3,9 @@
 import sys
 sys.path.append('../../build/.')
 import time
+import copy
+import ctypes
+from types import SimpleNamespace
 from abc import ABC, abstractmethod
 import integration as itg
 import numpy as np
@@ -91,8 +94,10 @@ def add_estim_pol_order(cls):
 
         """
         Method to compute the polynomial order of a class.
-        The method computes the integral of x^i, starting with i = 0 and proceding until the result is not correct.
-        In that case, it means that we have reached the order.
+        The method computes the integral of x^i on [0, 1], starting with i = 0 and proceding until the result is
+        not correct. In that case, it means that we have reached the order. The computation is done in C++ (see
+        itg.polynomial_order) when the rule allows it, otherwise through the C++ backend of a copy of the object
+        (see _backend_integral); in both cases the object is not modified.
     
         Parameters:
         - no parameters
@@ -102,53 +107,119 @@ def add_estim_pol_order(cls):
             The estimation of the polynomial order.
         """
 
-        i=0 # counter used to keep trace of the integral computed correctly
+        rule_and_nodes = _rule_and_nodes(self)
+        if rule_and_nodes is not None:
+            return itg.polynomial_order(*rule_and_nodes)
 
-        # Now we save the old attributes of the class, as they will be modified during the execution of the 
-        # function. In order to avoid having side effects, we save them and we re-set them once computations
-        # have been done.
+        max_degree = 100    # as in itg.polynomial_order, since the adaptive rules may be exact for every power
 
-        old_subdivision_n = self.subdivision_n
-        old_integrand = self.integrand
+        for i in range(max_degree+1):
+            if abs(_backend_integral(self, lambda x: x**i, 1) - 1/(i+1)) >= 1e-8:
+                if i == 0:
+                    raise RuntimeError('The rule does not integrate even the constants exactly.')
+                return i-1
 
-        self.subdivision_n=1 # Simple version, not the composite one. Otherwise we could overestimate the order,
-        # due to the higher effectiveness of the composite version.
+        return max_degree
 
-        def f(x,k=i):
-            return x**k    # We need to test for  which degrees of x^i the integration method is exact
-        
-        self.integrand=f
+    cls.__estim_pol_order=__estim_pol_order     # add the method to the class and return the class.
 
-        result=self.cpp_backend.compute_integral()
-        exact_result = (self.end**(i+1)-self.begin**(i+1))/(i+1)
+    return cls
 
-        while abs(result-exact_result)<1e-8:   # check if they coincide, apart from maybe minimal errors due to
-            # floating point arithmetics.
-             
-            i+=1   # If they do, we increase our estimation of the order.
 
-            def f(x,k=i):       # higher degree now
-                return x**k
-            
-            self.integrand=f
 
-            result=self.cpp_backend.compute_integral()      # We call the backend version of compute integral
-            # because the one of python classes will be decorated using timer and it would have printed the time
-            # each time the method is called, which is not useful in this context. 
+# The orders are estimated in C++ for the rules of the classes having the class attribute 'rule', provided that
+# the Gaussian rules use Legendre polynomials, since the estimation uses the weight 1. For the other integrators
+# the integrals are computed by the C++ backend of a copy of the object, on [0, 1] and with the given integrand
+# and number of subintervals.
 
-            exact_result = (self.end**(i+1)-self.begin**(i+1))/(i+1)
 
-        self.subdivision_n = old_subdivision_n    # To avoid side effects.
-        self.integrand = old_integrand
 
-        return i-1  # we return i-1 and not i because i is incremented before actually doing the check: if i is
-            # equal to the polynomial, then we increment it and we find an incorrect result, meaning that the 
-            # result was correct before incrementing it  
+def _rule_and_nodes(integrator):
 
-    cls.__estim_pol_order=__estim_pol_order     # add the method to the class and return the class.
+    """
+    Return the rule of an integrator and its number of nodes, as accepted by itg.polynomial_order and by
+    itg.real_convergence_study / itg.complex_convergence_study.
+
+    Parameters:
+    - integrator: RealBase or ComplexBase
+        The integrator.
+
+    Returns:
+    - tuple or None:
+        (str, int) couple: the name of the rule and the number of nodes (only used by Gaussian rules), or None if
+        the orders of the integrator cannot be estimated in C++.
+    """
+
+    rule = getattr(integrator, 'rule', None)
+
+    if rule is None or (rule == 'Gaussian' and integrator.family_of_polynomials != 'Legendre'):
+        return None
+
+    return rule, getattr(integrator, 'number_of_nodes', 5)
+
+
+
+def _backend_integral(integrator, integrand, subdivision_n):
+
+    """
+    Compute the integral on [0, 1] of the given integrand with the C++ backend of a copy of the integrator, with
+    subdivision_n subintervals.
+
+    Parameters:
+    - integrator: RealBase or ComplexBase
+        The integrator, which is not modified.
+    - integrand: function
+        A scalar function of a real variable.
+    - subdivision_n: int
+        The number of subintervals.
+
+    Returns:
+    - float or complex:
+        The computed integral.
+    """
+
+    integrator = copy.copy(integrator)
+    integrator.begin, integrator.end, integrator.subdivision_n = 0, 1, subdivision_n
+    integrator.integrand, integrator.vectorized = integrand, False
+
+    return integrator.cpp_backend.compute_integral()
+
+
+
+def _python_convergence_study(integrator, k, subdivisions):
+
+    """
+    Fallback of itg.real_convergence_study / itg.complex_convergence_study for the integrators whose rule is not
+    known in C++: the same least-squares fit, with the integrals of x^k computed by _backend_integral.
+
+    Parameters:
+    - integrator: RealBase or ComplexBase
+        The integrator, which is not modified.
+    - k: int
+        The exponent of the integrand x^k.
+    - subdivisions: list of int
+        The numbers of subintervals.
+
+    Returns:
+    - SimpleNamespace:
+        With the attributes subdivisions, errors and convergence_order, as the result of the C++ study.
+    """
+
+    if any(n <= 0 for n in subdivisions):
+        raise ValueError('The numbers of subintervals must be positive.')
+
+    exact = 1/(k+1)
+    errors = [abs(_backend_integral(integrator, lambda x: x**k, n) - exact) for n in subdivisions]
+
+    noise = 64*np.finfo(float).eps*max(1, abs(exact))    # the errors at the level of the rounding errors are discarded
+    used = [(np.log(n), np.log(error)) for n, error in zip(subdivisions, errors) if error > noise]
+
+    convergence_order = float('nan')
+    if len(used) >= 2 and len(set(x for x, _ in used)) >= 2:
+        convergence_order = -np.polyfit(*zip(*used), 1)[0]
+
+    return SimpleNamespace(subdivisions=list(subdivisions), errors=errors, convergence_order=convergence_order)
 
-    return cls
-    
 
 
 
@@ -177,89 +248,71 @@ def add_estim_orders(cls):
         Enhanced with the new functionality.
     """
 
-    def estim_orders(self, plots=False):
+    def estim_orders(self, plots=False, subdivisions=(1, 2, 4, 8, 16)):
 
         """
         Method to compute the polynomial and convergence order of a class.
-        The polynomial order is computed using __estim_pol_order
-        The convergence order is computed taking a function for which the computed integral is not exact and then
-        reducing the stepsize, to see to which power the error decreases.
+        The polynomial order p is computed using __estim_pol_order
+        The convergence order is computed taking the function x^(p+1), for which the computed integral on [0, 1]
+        is not exact, and integrating it with each one of the given numbers of subintervals: the order is the
+        slope of the least-squares line through the points (log(n), -log(error)). When the rule allows it,
+        everything (including the fit) is done in C++ in a single call, the levels being computed in parallel;
+        otherwise the levels are computed by the C++ backend of a copy of the object. The object is not modified.
     
         Parameters:
         -plot: bool, optional
             Default value: False
-            If plot is True, then the method also plots a line corresponding to the plot of the error after and 
-            before reducing the stepsize, in logarithmic scale. The order of convergence can be estimated using
-            the steepness of that straight line, so it can be interesting if you want to check yourself that
-            things parse.
-            
+            If plot is True, then the method also plots the error against the number of subintervals, in
+            logarithmic scale. The order of convergence can be estimated using the steepness of that straight
+            line, so it can be interesting if you want to check yourself that things parse.
+        -subdivisions: list of int, optional
+            Default value: (1, 2, 4, 8, 16)
+            The numbers of subintervals used in the fit. The errors at the level of the rounding errors are not
+            used, so the finest levels should not be too fine for high-order rules.
 
         Returns:
         - tuple:
             (int, int) couple. The first element is the estimation of the polynomial order, the second one the
-            estimation of the order of convergence.
+            estimation of the order of convergence (None if it cannot be estimated).
 
         """
 
-        old_subdivision_n = self.subdivision_n   # to avoid side effects.
-        old_integrand = self.integrand
-        old_begin = self.begin
-        old_end = self.end
-        self.begin = 0 # not necessary actually, but to make it more uniform
-        self.end = 1
-
-
-        i = self.__estim_pol_order()
-        i+=1     # we estimate the polynomial order and we take a power of x with a higher exponent.
-        # In this way, the formula will not be exact, hence it is sensible to reduce the stepsize to see
-        # the power according to which the error decreases.
-
-        def f(x,j=i):
-            return x**j
-        
-        self.integrand=f
-
-        exact_result = ((self.end-self.begin)**(i+1))/(i+1)
-        errors=[]
+        rule_and_nodes = _rule_and_nodes(self)
+        polyn_order = self.__estim_pol_order()
 
-        for i in [1,10]: # compute first for a stepsize h equal to end-begin and then for h_new = (1/10)*h_old.
-            # Hence, if the method has order p, the new error should be approximately equal to ((1/10)^p)*old_error
-             
-            self.subdivision_n=i
+        k = polyn_order+1   # a power of x with a higher exponent, for which the formula is not exact.
 
-            result=self.cpp_backend.compute_integral()
-            errors.append(abs(result-exact_result))
-        
-        log_errors=[np.log10(errors[i]) for i in [0,-1]]   #  in logplots, the order is the angular coefficient
-        # of the straight line joining the two points. 
+        if rule_and_nodes is not None:
+            rule, number_of_nodes = rule_and_nodes
+            convergence_study = itg.complex_convergence_study if isinstance(self, ComplexBase) else itg.real_convergence_study
+            study = convergence_study(rule, lambda x: x**k, 1/(k+1), list(subdivisions), 0, 1, number_of_nodes, self.num_threads)
+        else:
+            study = _python_convergence_study(self, k, list(subdivisions))
 
         if plots:
             import matplotlib.pyplot as plt    # lazy way of importing
 
-            plt.plot([1,10], log_errors, label='Absolute value of the error') # for some reason, this gives some warnings. However, it does
-            # not change the correctness of the plot or of the result.
+            plt.plot(np.log10(study.subdivisions), np.log10(study.errors), 'o-', label='Absolute value of the error')
 
             plt.title('Error trend')
-            plt.xlabel('Number of nodes')
+            plt.xlabel('log10(number of subintervals)')
             plt.ylabel('log10(error)')
             plt.legend()
             plt.show()
 
-        conv_order = round(abs(np.log10(errors[-1])-np.log10(errors[0])))    # rounded to have an integer
-        polyn_order = self.__estim_pol_order()
-
         print(f'The method has polynomial order equal to {polyn_order}.')
 
+        if np.isnan(study.convergence_order):    # e.g. for adaptive rules, whose errors are all rounding errors
+            print('The convergence order cannot be estimated, since the errors are at the level of the rounding errors.')
+            return polyn_order, None
+
+        conv_order = round(study.convergence_order)    # rounded to have an integer
+
         if conv_order == polyn_order+1:
             print(f'The method has convergence order equal to {conv_order}. This is be correct, since it is equal to 1 + the polynomial order.')
         else:
             print(f'The method has convergence order equal to {conv_order}. It should have order {polyn_order+1}.')
 
-        self.subdivision_n = old_subdivision_n
-        self.integrand = old_integrand
-        self.begin = old_begin
-        self.end = old_end
-
         return polyn_order, conv_order
 
     cls.estim_orders=estim_orders
@@ -294,14 +347,24 @@ class RealBase(ABC):
         Number of points used for subdivision of the interval in order to perform composite integration.
     -integrand: function
         The real-valued function we want to integrate.
+    -num_threads: int, optional
+        Number of threads used by compute_integral(). The default 0 means itg.get_default_num_threads(); the result
+        does not depend on it.
+    -vectorized: bool, optional
+        If True, the integrand is called with a NumPy array of nodes (a read-only view, valid only during the call)
+        and must return the array of its values, e.g. lambda x: np.sin(x)**2. This is much faster than calling it
+        once for each node.
+        Default value = False
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
         self.begin=begin
         self.end=end
         self.subdivision_n=subdivision_n
         self.integrand=integrand
+        self.num_threads=num_threads
+        self.vectorized=vectorized
 
 
 
@@ -336,6 +399,7 @@ class RealBase(ABC):
         list:
             This is the partition of the interval used for composite integration. It is automatically created once
         object has been instantiated. It is modified each time one of the other attributes is modified. 
+        The C++ backend computes the points on demand, so the list is only created when this attribute is accessed.
         """
 
         return self.cpp_base_backend.partition
@@ -403,6 +467,122 @@ class RealBase(ABC):
         pass      # it is an abstract method. We provide no definition
 
 
+
+    # The following methods run the computation with the C++ backend of the derived class (its property
+    # cpp_backend), using the number of threads chosen by the user.
+
+
+
+    def _threaded_backend(self):
+
+        """
+        Return the C++ backend of the derived class, with the attribute num_threads of the object.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Real_Base or derived class
+            The C++ backend.
+        """
+
+        backend = self.cpp_backend
+        backend.num_threads = self.num_threads
+        return backend
+
+
+
+    def _compute_and_save(self, *attributes):
+
+        """
+        Compute the integral with the C++ backend and copy the given attributes of the backend (e.g. error_estimate),
+        which are set by its compute_integral(), into the object.
+
+        Parameters:
+        - attributes: str
+            The names of the attributes.
+
+        Returns:
+        - float
+            The result of the integration.
+        """
+
+        backend = self._threaded_backend()
+        result = backend.compute_integral()
+        for attribute in attributes:
+            setattr(self, attribute, getattr(backend, attribute))
+        return result
+
+
+
+    # The integration can also run in the background.
+
+
+
+    def compute_integral_async(self):
+
+        """
+        Start the computation of the integral in a background C++ thread and return immediately. Many integrations
+        can be started in this way and run at the same time: the GIL is released while they run (Python integrands
+        take it back when called, native ones never need it). The attributes set by compute_integral() in some
+        derived classes (e.g. error_estimate) are not set.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Real_Future or itg.Complex_Future
+            An object whose method result() waits for the integral and returns it; done() and wait(timeout) can
+            be used to poll it.
+        """
+
+        return self._threaded_backend().compute_integral_async()
+
+
+
+    def compute_with_error(self):
+
+        """
+        Compute the integral together with an estimate of its error, using the C++ backend of the derived class.
+        The Newton-Cotes rules compare the result with the one of an embedded coarser rule (on the same evaluations
+        of the integrand), the Gaussian rules with the one of the Gaussian rule with one node less, the iterative
+        ones return their own error_estimate. It is inf for the integrators which cannot estimate the error.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Real_Integration_Result
+            An object with the attributes value (the same returned by compute_integral()), error_estimate and
+            evaluations (the number of evaluations of the integrand).
+        """
+
+        return self._threaded_backend().compute_with_error()
+
+
+
+    def compute_cumulative(self):
+
+        """
+        Compute the integrals on [begin, x_i] for all the points x_i of the partition in a single sweep, using the
+        same evaluations of the integrand as compute_integral(). It is implemented in C++. Only available for the
+        composite rules: midpoint, trapezoidal, Simpson and Gauss-Legendre.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - numpy.ndarray of float64
+            The subdivision_n+1 integrals: the first one is 0 and the last one is the whole integral.
+        """
+
+        backend = self._threaded_backend()
+        if not hasattr(backend, 'compute_cumulative'):
+            raise NotImplementedError(f'compute_cumulative() is not available for {type(self).__name__}.')
+        return backend.compute_cumulative()
+
+
+
     # Just to print some nicer things:
 
 
@@ -431,11 +611,16 @@ class RealMidpoint(RealBase):
         Number of points used for subdivision of the interval in order to perform composite integration.
     -integrand: function
         The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        RealBase.__init__(self, begin, end, subdivision_n, integrand)
+    rule='Midpoint'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
 
 
     # We define the C++ backend, which will be used for computations.
@@ -452,7 +637,7 @@ class RealMidpoint(RealBase):
             
         """
 
-        return itg.Real_Midpoint(self.begin, self.end, self.subdivision_n, self.integrand)
+        return itg.Real_Midpoint(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
     
 
 
@@ -475,8 +660,8 @@ class RealMidpoint(RealBase):
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
-    
+        return self._threaded_backend().compute_integral()
+
 
 
     def __repr__(self):
@@ -502,11 +687,16 @@ class RealTrapezoidal(RealBase):
         Number of points used for subdivision of the interval in order to perform composite integration.
     -integrand: function
         The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        RealBase.__init__(self, begin, end, subdivision_n, integrand)
+    rule='Trapezoidal'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
 
 
 
@@ -520,7 +710,7 @@ class RealTrapezoidal(RealBase):
             
         """
 
-        return itg.Real_Trapezoidal(self.begin, self.end, self.subdivision_n, self.integrand)
+        return itg.Real_Trapezoidal(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
     
 
     
@@ -539,7 +729,7 @@ class RealTrapezoidal(RealBase):
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
+        return self._threaded_backend().compute_integral()
 
 
 
@@ -566,11 +756,16 @@ class RealSimpson(RealBase):
         Number of points used for subdivision of the interval in order to perform composite integration.
     -integrand: function
         The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        RealBase.__init__(self, begin, end, subdivision_n, integrand)
+    rule='Simpson'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
 
 
 
@@ -584,7 +779,7 @@ class RealSimpson(RealBase):
             
         """
 
-        return itg.Real_Simpson(self.begin, self.end, self.subdivision_n, self.integrand)
+        return itg.Real_Simpson(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
     
 
 
@@ -603,8 +798,8 @@ class RealSimpson(RealBase):
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
-    
+        return self._threaded_backend().compute_integral()
+
 
 
     def __repr__(self):
@@ -641,11 +836,16 @@ class RealGaussian(RealBase):
     -beta: float, optional
         Value used, e.g., in exponential integration.
         Default value = 1
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand, number_of_nodes, family_of_polynomials='Legendre', alpha=1, beta=1):
-        RealBase.__init__(self, begin, end , subdivision_n, integrand)
+    rule='Gaussian'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, number_of_nodes, family_of_polynomials='Legendre', alpha=1, beta=1, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end , subdivision_n, integrand, num_threads, vectorized=vectorized)
         self.number_of_nodes=number_of_nodes
         self.family_of_polynomials=family_of_polynomials
         self.alpha=alpha
@@ -663,7 +863,7 @@ class RealGaussian(RealBase):
             
         """
 
-        return itg.Real_Gaussian(self.begin, self.end, self.subdivision_n, self.integrand, self.number_of_nodes, self.family_of_polynomials, self.alpha, self.beta)
+        return itg.Real_Gaussian(self.begin, self.end, self.subdivision_n, self.integrand, self.number_of_nodes, self.family_of_polynomials, self.alpha, self.beta, vectorized=self.vectorized)
 
 
 
@@ -682,8 +882,8 @@ class RealGaussian(RealBase):
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
-    
+        return self._threaded_backend().compute_integral()
+
 
 
     def __repr__(self):
@@ -693,13 +893,12 @@ class RealGaussian(RealBase):
 
 
 
-
-@add_estim_pol_order
-@add_estim_orders
-class ComplexBase(ABC):
+class RealAdaptive(RealBase):
 
     """
-    Base, abstract class to perform composite numerical integration of complex-valued functions.
+    Class to perform adaptive numerical integration of real-valued functions: the subintervals with the largest
+    estimated error (computed through the 15-point Gauss-Kronrod rule) are bisected until the tolerance is reached.
+    It inherits from RealBase. The constructor also adds some new attributes.
 
     Parameters:
     - begin: float
@@ -707,108 +906,77 @@ class ComplexBase(ABC):
     -end: float
         Right endpoint of the integration interval
     -subdivision_n: int
-        Number of points used for subdivision of the interval in order to perform composite integration.
+        Number of subintervals we start from.
     -integrand: function
         The real-valued function we want to integrate.
+    -tolerance: float, optional
+        Absolute tolerance on the estimated error.
+        Default value = 1e-10
+    -max_subintervals: int, optional
+        Maximum number of subintervals: if it is reached, the integration stops even if the tolerance is not.
+        Default value = 10000
+    -vectorized: bool, optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        self.begin=begin
-        self.end=end
-        self.subdivision_n=subdivision_n
-        self.integrand=integrand
-
-
-
-    @property
-    def cpp_base_backend(self):
-
-        """
-        itg.Complex_Base object
-            This is the C++ backend of the base integrator. It is automatically created once an object is instantiated
-            and gets uploaded each time one of the other attributes is modified.
-        """
-
-        return itg.Complex_Base(self.begin, self.end, self.subdivision_n, self.integrand)
-    
-
-
-    @property
-    def partition(self):
-
-        """
-        list:
-            This is the partition of the interval used for composite integration. It is automatically created once
-        object has been instantiated. It is modified each time one of the other attributes is modified. 
-        """
-
-        return self.cpp_base_backend.partition
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_subintervals=10000, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_subintervals=max_subintervals
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
 
 
 
     @property
-    def h(self):
-
-        """
-        float:
-            The stepsize used for composite integration. It is automatically created once the object is instantiated.
-        It is modified each time one of the other parameters is upgraded.
-        """
-
-        return self.cpp_base_backend.h
-        
-
-
-    @h.setter
-    def h(self, new_h):
+    def cpp_backend(self):
 
         """
-        Setter method for the stepsize.
-        It upgrades the stepsize by changing the value of subdivision_n.
-
-        Parameters:
-        - float:
-            The new stepsize to be used in complex integration.
-
-        Returns:
-        - nothing
+        itg.Real_Adaptive object:
+            This is the C++ backend of the real adaptive integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
         """
 
-        self.subdivision_n = int((self.end-self.begin)/new_h)
+        return itg.Real_Adaptive(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_subintervals, vectorized=self.vectorized)
 
 
 
-    @abstractmethod
+    @timer
     def compute_integral(self):
 
         """
-        Compute the integral according to the attributes of the class.
-        This is an abstract method, hence it is supposed to be overridden and no implementation is given.
+        Compute the integral according to the attributes of the class using adaptive Gauss-Kronrod integration.
+        It is implemented in C++. The estimated error, the number of evaluations of the integrand and whether the
+        tolerance was reached are saved in error_estimate, evaluations and converged.
 
         Parameters:
         - no parameters
 
         Returns:
-        - it cannot be called, being an abstract methods, hence it cannot return anything
+        - float
+            The result of the integration.
         """
 
-        pass
-
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged')
+    
 
 
     def __repr__(self):
-        return "py_integration.<ComplexBase> object. Call 'help' for further details."
+        return "py_integration.<RealAdaptive> object. Call 'help' for further details."
 
 
 
 
 
+class RealRomberg(RealBase):
 
-class ComplexMidpoint(ComplexBase):
     """
-    Class to perform composite numerical integration of complex-valued functions through the composite midpoint rule.
-    It inherits from ComplexBase. The constructor is the same of the base class.
+    Class to perform Romberg integration of real-valued functions: the stepsize of the trapezoidal rule is halved
+    at each level, evaluating the integrand only in the new midpoints, and the results are improved through
+    Richardson extrapolation. It inherits from RealBase. The constructor also adds some new attributes.
 
     Parameters:
     - begin: float
@@ -816,15 +984,28 @@ class ComplexMidpoint(ComplexBase):
     -end: float
         Right endpoint of the integration interval
     -subdivision_n: int
-        Number of points used for subdivision of the interval in order to perform composite integration.
+        Number of subintervals of the first level.
     -integrand: function
         The real-valued function we want to integrate.
+    -tolerance: float, optional
+        Tolerance on the difference between two consecutive extrapolated values.
+        Default value = 1e-10
+    -max_levels: int, optional
+        Maximum number of levels.
+        Default value = 20
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-
-    def __init__(self, begin, end, subdivision_n, integrand):
-        ComplexBase.__init__(self, begin, end, subdivision_n, integrand)
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_levels=20, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_levels=max_levels
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.levels=None
 
 
 
@@ -832,48 +1013,50 @@ class ComplexMidpoint(ComplexBase):
     def cpp_backend(self):
 
         """
-        itg.Complex_Midpoind object:
-            This is the C++ backend of the complex gaussian integrator. It is automatically created once an object
+        itg.Real_Romberg object:
+            This is the C++ backend of the real Romberg integrator. It is automatically created once an object
             is instantiated and gets uploaded each time one of the other attributes is modified.
             
         """
 
-        return itg.Complex_Midpoint(self.begin, self.end, self.subdivision_n, self.integrand)
-    
+        return itg.Real_Romberg(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_levels, vectorized=self.vectorized)
+
 
 
     @timer
     def compute_integral(self):
-   
+
         """
-        Compute the integral according to the attributes of the class using the composite midpoint rule.
-        It is implemented in C++.
+        Compute the integral according to the attributes of the class using Romberg integration.
+        It is implemented in C++. The estimated error, the number of evaluations of the integrand, whether the
+        tolerance was reached and the number of levels are saved in error_estimate, evaluations, converged and levels.
 
         Parameters:
         - no parameters
 
         Returns:
-        - complex
+        - float
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'levels')
     
 
 
     def __repr__(self):
-        return "py_integration.<ComplexMidpoint> object. Call 'help' for further details."
+        return "py_integration.<RealRomberg> object. Call 'help' for further details."
 
 
 
 
 
-
-class ComplexTrapezoidal(ComplexBase):
+class RealClenshawCurtis(RealBase):
 
     """
-    Class to perform composite numerical integration of complex-valued functions through the composite trapezoidal rule.
-    It inherits from ComplexBase. The constructor is the same of the base class.
+    Class to perform Clenshaw-Curtis integration of real-valued functions: on each subinterval the level of the
+    rule (2^level + 1 Chebyshev points) is increased until two consecutive results differ by less than the
+    tolerance. The nodes are nested, so each level only evaluates the integrand in the new points. It inherits
+    from RealBase. The constructor also adds some new attributes.
 
     Parameters:
     - begin: float
@@ -881,13 +1064,28 @@ class ComplexTrapezoidal(ComplexBase):
     -end: float
         Right endpoint of the integration interval
     -subdivision_n: int
-        Number of points used for subdivision of the interval in order to perform composite integration.
+        Number of subintervals, on each of which the Clenshaw-Curtis rule is used.
     -integrand: function
         The real-valued function we want to integrate.
+    -tolerance: float, optional
+        Tolerance on the difference between the results of two consecutive levels.
+        Default value = 1e-10
+    -max_level: int, optional
+        Maximum level (the rule of level k has 2^k + 1 nodes on each subinterval).
+        Default value = 12
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        ComplexBase.__init__(self, begin, end, subdivision_n, integrand)
+
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_level=12, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_level=max_level
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.level=None
 
 
 
@@ -895,48 +1093,50 @@ class ComplexTrapezoidal(ComplexBase):
     def cpp_backend(self):
 
         """
-        itg.Complex_Trapezoidal object:
-            This is the C++ backend of the complex trapezoidal integrator. It is automatically created once an object
+        itg.Real_Clenshaw_Curtis object:
+            This is the C++ backend of the real Clenshaw-Curtis integrator. It is automatically created once an object
             is instantiated and gets uploaded each time one of the other attributes is modified.
             
         """
 
-        return itg.Complex_Trapezoidal(self.begin, self.end, self.subdivision_n, self.integrand)
-    
+        return itg.Real_Clenshaw_Curtis(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_level, vectorized=self.vectorized)
+
 
 
     @timer
     def compute_integral(self):
 
         """
-        Compute the integral according to the attributes of the class using the composite trapezoidal rule.
-        It is implemented in C++.
+        Compute the integral according to the attributes of the class using Clenshaw-Curtis integration.
+        It is implemented in C++. The estimated error, the number of evaluations of the integrand, whether the
+        tolerance was reached and the last level used are saved in error_estimate, evaluations, converged and level.
 
         Parameters:
         - no parameters
 
         Returns:
-        - complex
+        - float
             The result of the integration.
         """
 
-        return self.cpp_backend.compute_integral()
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'level')
     
 
 
     def __repr__(self):
-        return "py_integration.<ComplexTrapezoidal> object. Call 'help' for further details."
-    
+        return "py_integration.<RealClenshawCurtis> object. Call 'help' for further details."
 
 
 
 
 
-class ComplexSimpson(ComplexBase):
+class RealDoubleExponential(RealBase):
 
     """
-    Class to perform composite numerical integration of real-valued functions through the composite Simpson rule.
-    It inherits from RealBase. The constructor is the same of the base class.
+    Class to perform tanh-sinh (double exponential) integration of real-valued functions, which converges
+    exponentially fast also when the integrand has singularities at the endpoints (e.g. sqrt(x*(1-x)) or
+    1/sqrt(x)), since the endpoints are never evaluated. At each level the step is halved and the integrand is only
+    evaluated in the new nodes. It inherits from RealBase. The constructor also adds some new attributes.
 
     Parameters:
     - begin: float
@@ -944,14 +1144,28 @@ class ComplexSimpson(ComplexBase):
     -end: float
         Right endpoint of the integration interval
     -subdivision_n: int
-        Number of points used for subdivision of the interval in order to perform composite integration.
+        Number of subintervals, on each of which the tanh-sinh rule is used.
     -integrand: function
         The real-valued function we want to integrate.
+    -tolerance: float, optional
+        Tolerance on the difference between the results of two consecutive levels.
+        Default value = 1e-10
+    -max_level: int, optional
+        Maximum level (the step of the rule is 2^-level).
+        Default value = 8
+    -num_threads, vectorized: optional
+        See RealBase.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand):
-        ComplexBase.__init__(self, begin, end, subdivision_n, integrand)
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_level=8, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_level=max_level
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.level=None
 
 
 
@@ -959,47 +1173,49 @@ class ComplexSimpson(ComplexBase):
     def cpp_backend(self):
 
         """
-        itg.Complex_Simpson object:
-            This is the C++ backend of the complex Simpson integrator. It is automatically created once an object
+        itg.Real_Double_Exponential object:
+            This is the C++ backend of the real tanh-sinh integrator. It is automatically created once an object
             is instantiated and gets uploaded each time one of the other attributes is modified.
             
         """
 
-        return itg.Complex_Simpson(self.begin, self.end, self.subdivision_n, self.integrand)
-    
+        return itg.Real_Double_Exponential(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_level, vectorized=self.vectorized)
+
 
 
     @timer
     def compute_integral(self):
 
         """
-        Compute the integral according to the attributes of the class using the composite Simpson rule.
-        It is implemented in C++.
+        Compute the integral according to the attributes of the class using tanh-sinh integration.
+        It is implemented in C++. The estimated error, the number of evaluations of the integrand, whether the
+        tolerance was reached and the last level used are saved in error_estimate, evaluations, converged and level.
 
         Parameters:
         - no parameters
 
         Returns:
-        - complex
+        - float
             The result of the integration.
         """
-        return self.cpp_backend.compute_integral()
+
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'level')
     
 
 
     def __repr__(self):
-        return "py_integration.<ComplexSimpson> object. Call 'help' for further details."
-    
+        return "py_integration.<RealDoubleExponential> object. Call 'help' for further details."
 
 
 
 
 
-class ComplexGaussian(ComplexBase):
+class RealVectorIntegration:
 
     """
-    Class to perform composite numerical integration of complex-valued functions through the Gaussian quadrature rule.
-    It inherits from ComplexBase. The constructor also adds some new attributes.
+    Class to integrate real-valued vector functions, i.e. functions returning a list of number_of_outputs values
+    (e.g. the first moments of a distribution). All the integrals are computed evaluating the function only once
+    in each node. Unlike the other classes, it does not inherit from RealBase, since it computes a list of integrals.
 
     Parameters:
     - begin: float
@@ -1008,28 +1224,31 @@ class ComplexGaussian(ComplexBase):
         Right endpoint of the integration interval
     -subdivision_n: int
         Number of points used for subdivision of the interval in order to perform composite integration.
+    -number_of_outputs: int
+        Number of values returned by the integrand.
     -integrand: function
-        The real-valued function we want to integrate.
-    -number_of_nodes: int
-        The number of nodes used for the interpolatorial quadrature rule.
-    -family_of_polynomials: string, optional
-        Weight function against which integration is performed.
-        Default value = 'Legendre'
-    -alpha: float, optional
-        Value used e.g. in Gegenbauer integration.
-        Default value = 1
-    -beta: float, optional
-        Value used, e.g., in exponential integration.
-        Default value = 1
+        The function we want to integrate. It must return a list of number_of_outputs real values.
+    -rule: string, optional
+        'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).
+        Default value = 'Simpson'
+    -number_of_nodes: int, optional
+        The number of nodes of the Gaussian rule.
+        Default value = 5
+    -num_threads: int, optional
+        Number of threads used by compute_integral(). The default 0 means itg.get_default_num_threads(); the result
+        does not depend on it.
     """
 
 
-    def __init__(self, begin, end, subdivision_n, integrand, number_of_nodes, family_of_polynomials='Legendre', alpha=1, beta=1):
-        RealBase.__init__(self, begin, end , subdivision_n, integrand)
+    def __init__(self, begin, end, subdivision_n, number_of_outputs, integrand, rule='Simpson', number_of_nodes=5, num_threads=0):
+        self.begin=begin
+        self.end=end
+        self.subdivision_n=subdivision_n
+        self.number_of_outputs=number_of_outputs
+        self.integrand=integrand
+        self.rule=rule
         self.number_of_nodes=number_of_nodes
-        self.family_of_polynomials=family_of_polynomials
-        self.alpha=alpha
-        self.beta=beta
+        self.num_threads=num_threads
 
 
 
@@ -1037,29 +1256,29 @@ class ComplexGaussian(ComplexBase):
     def cpp_backend(self):
 
         """
-        itg.Complex_Gaussian object:
-            This is the C++ backend of the complex Gaussian integrator. It is automatically created once an object
-            is instantiated and gets uploaded each time one of the other attributes is modified.
-            
+        itg.Real_Vector_Integration object:
+            This is the C++ backend of the integrator. It is automatically created once an object is instantiated
+            and gets uploaded each time one of the other attributes is modified.
         """
 
-        return itg.Complex_Gaussian(self.begin, self.end, self.subdivision_n, self.integrand, self.number_of_nodes, self.family_of_polynomials, self.alpha, self.beta)
+        backend = itg.Real_Vector_Integration(self.begin, self.end, self.subdivision_n, self.number_of_outputs, self.integrand, self.rule, self.number_of_nodes)
+        backend.num_threads = self.num_threads
+        return backend
 
 
 
     @timer
     def compute_integral(self):
-          
+
         """
-        Compute the integral according to the attributes of the class using the chosen Gaussian quadrature formula.
-        It is implemented in C++.
+        Compute the integrals of the components of the integrand. It is implemented in C++.
 
         Parameters:
         - no parameters
 
         Returns:
-        - complex
-            The result of the integration.
+        - list of float
+            The integrals of the number_of_outputs components.
         """
 
         return self.cpp_backend.compute_integral()
@@ -1067,12 +1286,1166 @@ class ComplexGaussian(ComplexBase):
 
 
     def __repr__(self):
-        return "py_integration.<ComplexGaussian> object. Call 'help' for further details."
+        return "py_integration.<RealVectorIntegration> object. Call 'help' for further details."
+
+
+
+
+
+
+@add_estim_pol_order
+@add_estim_orders
+class ComplexBase(ABC):
+
+    """
+    Base, abstract class to perform composite numerical integration of complex-valued functions.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -integrand: function
+        The real-valued function we want to integrate.
+    -num_threads: int, optional
+        Number of threads used by compute_integral(). The default 0 means itg.get_default_num_threads(); the result
+        does not depend on it.
+    -vectorized: bool, optional
+        If True, the integrand is called with a NumPy array of nodes (a read-only view, valid only during the call)
+        and must return the array of its values, e.g. lambda x: np.sin(x)**2. This is much faster than calling it
+        once for each node.
+        Default value = False
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        self.begin=begin
+        self.end=end
+        self.subdivision_n=subdivision_n
+        self.integrand=integrand
+        self.num_threads=num_threads
+        self.vectorized=vectorized
+
+
+
+    @property
+    def cpp_base_backend(self):
+
+        """
+        itg.Complex_Base object
+            This is the C++ backend of the base integrator. It is automatically created once an object is instantiated
+            and gets uploaded each time one of the other attributes is modified.
+        """
+
+        return itg.Complex_Base(self.begin, self.end, self.subdivision_n, self.integrand)
     
 
 
+    @property
+    def partition(self):
+
+        """
+        list:
+            This is the partition of the interval used for composite integration. It is automatically created once
+        object has been instantiated. It is modified each time one of the other attributes is modified. 
+        The C++ backend computes the points on demand, so the list is only created when this attribute is accessed.
+        """
+
+        return self.cpp_base_backend.partition
+
+
+
+    @property
+    def h(self):
+
+        """
+        float:
+            The stepsize used for composite integration. It is automatically created once the object is instantiated.
+        It is modified each time one of the other parameters is upgraded.
+        """
+
+        return self.cpp_base_backend.h
+        
+
+
+    @h.setter
+    def h(self, new_h):
+
+        """
+        Setter method for the stepsize.
+        It upgrades the stepsize by changing the value of subdivision_n.
+
+        Parameters:
+        - float:
+            The new stepsize to be used in complex integration.
+
+        Returns:
+        - nothing
+        """
+
+        self.subdivision_n = int((self.end-self.begin)/new_h)
+
+
+
+    @abstractmethod
+    def compute_integral(self):
+
+        """
+        Compute the integral according to the attributes of the class.
+        This is an abstract method, hence it is supposed to be overridden and no implementation is given.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - it cannot be called, being an abstract methods, hence it cannot return anything
+        """
+
+        pass
+
+
+
+    # The following methods run the computation with the C++ backend of the derived class (its property
+    # cpp_backend), using the number of threads chosen by the user.
+
+
+
+    def _threaded_backend(self):
+
+        """
+        Return the C++ backend of the derived class, with the attribute num_threads of the object.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Complex_Base or derived class
+            The C++ backend.
+        """
+
+        backend = self.cpp_backend
+        backend.num_threads = self.num_threads
+        return backend
+
+
+
+    def _compute_and_save(self, *attributes):
+
+        """
+        Compute the integral with the C++ backend and copy the given attributes of the backend (e.g. error_estimate),
+        which are set by its compute_integral(), into the object.
+
+        Parameters:
+        - attributes: str
+            The names of the attributes.
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        backend = self._threaded_backend()
+        result = backend.compute_integral()
+        for attribute in attributes:
+            setattr(self, attribute, getattr(backend, attribute))
+        return result
+
+
+
+    # The integration can also run in the background.
+
+
+
+    def compute_integral_async(self):
+
+        """
+        Start the computation of the integral in a background C++ thread and return immediately. Many integrations
+        can be started in this way and run at the same time: the GIL is released while they run (Python integrands
+        take it back when called, native ones never need it). The attributes set by compute_integral() in some
+        derived classes (e.g. error_estimate) are not set.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Real_Future or itg.Complex_Future
+            An object whose method result() waits for the integral and returns it; done() and wait(timeout) can
+            be used to poll it.
+        """
+
+        return self._threaded_backend().compute_integral_async()
+
+
+
+    def compute_with_error(self):
+
+        """
+        Compute the integral together with an estimate of its error, using the C++ backend of the derived class.
+        The Newton-Cotes rules compare the result with the one of an embedded coarser rule (on the same evaluations
+        of the integrand), the Gaussian rules with the one of the Gaussian rule with one node less, the iterative
+        ones return their own error_estimate. It is inf for the integrators which cannot estimate the error.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - itg.Complex_Integration_Result
+            An object with the attributes value (the same returned by compute_integral()), error_estimate and
+            evaluations (the number of evaluations of the integrand).
+        """
+
+        return self._threaded_backend().compute_with_error()
+
+
+
+    def compute_cumulative(self):
+
+        """
+        Compute the integrals on [begin, x_i] for all the points x_i of the partition in a single sweep, using the
+        same evaluations of the integrand as compute_integral(). It is implemented in C++. Only available for the
+        composite rules: midpoint, trapezoidal, Simpson and Gauss-Legendre.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - numpy.ndarray of complex128
+            The subdivision_n+1 integrals: the first one is 0 and the last one is the whole integral.
+        """
+
+        backend = self._threaded_backend()
+        if not hasattr(backend, 'compute_cumulative'):
+            raise NotImplementedError(f'compute_cumulative() is not available for {type(self).__name__}.')
+        return backend.compute_cumulative()
+
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexBase> object. Call 'help' for further details."
+
+
+
+
+
+
+class ComplexMidpoint(ComplexBase):
+    """
+    Class to perform composite numerical integration of complex-valued functions through the composite midpoint rule.
+    It inherits from ComplexBase. The constructor is the same of the base class.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -integrand: function
+        The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See ComplexBase.
+    """
+
+
+
+    rule='Midpoint'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Midpoind object:
+            This is the C++ backend of the complex gaussian integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Midpoint(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
+    
+
+
+    @timer
+    def compute_integral(self):
+   
+        """
+        Compute the integral according to the attributes of the class using the composite midpoint rule.
+        It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._threaded_backend().compute_integral()
+
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexMidpoint> object. Call 'help' for further details."
+
+
+
+
+
+
+class ComplexTrapezoidal(ComplexBase):
+
+    """
+    Class to perform composite numerical integration of complex-valued functions through the composite trapezoidal rule.
+    It inherits from ComplexBase. The constructor is the same of the base class.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -integrand: function
+        The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See ComplexBase.
+    """
+
+    rule='Trapezoidal'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Trapezoidal object:
+            This is the C++ backend of the complex trapezoidal integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Trapezoidal(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
+    
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral according to the attributes of the class using the composite trapezoidal rule.
+        It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._threaded_backend().compute_integral()
+
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexTrapezoidal> object. Call 'help' for further details."
+    
+
+
+
+
+
+class ComplexSimpson(ComplexBase):
+
+    """
+    Class to perform composite numerical integration of real-valued functions through the composite Simpson rule.
+    It inherits from RealBase. The constructor is the same of the base class.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -integrand: function
+        The real-valued function we want to integrate.
+    -num_threads, vectorized: optional
+        See ComplexBase.
+    """
+
+
+    rule='Simpson'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Simpson object:
+            This is the C++ backend of the complex Simpson integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Simpson(self.begin, self.end, self.subdivision_n, self.integrand, vectorized=self.vectorized)
+    
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral according to the attributes of the class using the composite Simpson rule.
+        It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+        return self._threaded_backend().compute_integral()
+
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexSimpson> object. Call 'help' for further details."
+    
+
+
+
+
+
+class ComplexGaussian(ComplexBase):
+
+    """
+    Class to perform composite numerical integration of complex-valued functions through the Gaussian quadrature rule.
+    It inherits from ComplexBase. The constructor also adds some new attributes.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -integrand: function
+        The real-valued function we want to integrate.
+    -number_of_nodes: int
+        The number of nodes used for the interpolatorial quadrature rule.
+    -family_of_polynomials: string, optional
+        Weight function against which integration is performed.
+        Default value = 'Legendre'
+    -alpha: float, optional
+        Value used e.g. in Gegenbauer integration.
+        Default value = 1
+    -beta: float, optional
+        Value used, e.g., in exponential integration.
+        Default value = 1
+    -num_threads, vectorized: optional
+        See ComplexBase.
+    """
+
+
+    rule='Gaussian'     # used to estimate the orders (see _rule_and_nodes)
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, number_of_nodes, family_of_polynomials='Legendre', alpha=1, beta=1, num_threads=0, vectorized=False):
+        RealBase.__init__(self, begin, end , subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.number_of_nodes=number_of_nodes
+        self.family_of_polynomials=family_of_polynomials
+        self.alpha=alpha
+        self.beta=beta
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Gaussian object:
+            This is the C++ backend of the complex Gaussian integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Gaussian(self.begin, self.end, self.subdivision_n, self.integrand, self.number_of_nodes, self.family_of_polynomials, self.alpha, self.beta, vectorized=self.vectorized)
+
+
+
+    @timer
+    def compute_integral(self):
+          
+        """
+        Compute the integral according to the attributes of the class using the chosen Gaussian quadrature formula.
+        It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._threaded_backend().compute_integral()
+
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexGaussian> object. Call 'help' for further details."
+
+
+
+
+
+class ComplexAdaptive(ComplexBase):
+
+    """
+    Same as RealAdaptive, for complex-valued integrands. It inherits from ComplexBase, and its parameters
+    and attributes are the same of RealAdaptive.
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_subintervals=10000, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_subintervals=max_subintervals
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Adaptive object:
+            This is the C++ backend of the complex adaptive integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Adaptive(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_subintervals, vectorized=self.vectorized)
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral as RealAdaptive.compute_integral() does. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged')
+    
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexAdaptive> object. Call 'help' for further details."
+
+
+
+
+
+class ComplexRomberg(ComplexBase):
+
+    """
+    Same as RealRomberg, for complex-valued integrands. It inherits from ComplexBase, and its parameters
+    and attributes are the same of RealRomberg.
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_levels=20, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_levels=max_levels
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.levels=None
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Romberg object:
+            This is the C++ backend of the complex Romberg integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Romberg(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_levels, vectorized=self.vectorized)
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral as RealRomberg.compute_integral() does. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'levels')
+    
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexRomberg> object. Call 'help' for further details."
+
+
+
+
+
+class ComplexClenshawCurtis(ComplexBase):
+
+    """
+    Same as RealClenshawCurtis, for complex-valued integrands. It inherits from ComplexBase, and its parameters
+    and attributes are the same of RealClenshawCurtis.
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_level=12, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_level=max_level
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.level=None
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Clenshaw_Curtis object:
+            This is the C++ backend of the complex Clenshaw-Curtis integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Clenshaw_Curtis(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_level, vectorized=self.vectorized)
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral as RealClenshawCurtis.compute_integral() does. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'level')
+    
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexClenshawCurtis> object. Call 'help' for further details."
+
+
+
+
+
+class ComplexDoubleExponential(ComplexBase):
+
+    """
+    Same as RealDoubleExponential, for complex-valued integrands. It inherits from ComplexBase, and its parameters
+    and attributes are the same of RealDoubleExponential.
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, integrand, tolerance=1e-10, max_level=8, num_threads=0, vectorized=False):
+        ComplexBase.__init__(self, begin, end, subdivision_n, integrand, num_threads, vectorized=vectorized)
+        self.tolerance=tolerance
+        self.max_level=max_level
+        self.error_estimate=None    # these ones are set by compute_integral
+        self.evaluations=None
+        self.converged=None
+        self.level=None
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Double_Exponential object:
+            This is the C++ backend of the complex tanh-sinh integrator. It is automatically created once an object
+            is instantiated and gets uploaded each time one of the other attributes is modified.
+            
+        """
+
+        return itg.Complex_Double_Exponential(self.begin, self.end, self.subdivision_n, self.integrand, self.tolerance, self.max_level, vectorized=self.vectorized)
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral as RealDoubleExponential.compute_integral() does. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - complex
+            The result of the integration.
+        """
+
+        return self._compute_and_save('error_estimate', 'evaluations', 'converged', 'level')
+    
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexDoubleExponential> object. Call 'help' for further details."
+
+
+
+
+
+class ComplexVectorIntegration:
+
+    """
+    Class to integrate complex-valued vector functions, i.e. functions returning a list of number_of_outputs values
+    (e.g. the first moments of a distribution). All the integrals are computed evaluating the function only once
+    in each node. Unlike the other classes, it does not inherit from ComplexBase, since it computes a list of integrals.
+
+    Parameters:
+    - begin: float
+        Left endpoint of the integration interval
+    -end: float
+        Right endpoint of the integration interval
+    -subdivision_n: int
+        Number of points used for subdivision of the interval in order to perform composite integration.
+    -number_of_outputs: int
+        Number of values returned by the integrand.
+    -integrand: function
+        The function we want to integrate. It must return a list of number_of_outputs complex values.
+    -rule: string, optional
+        'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).
+        Default value = 'Simpson'
+    -number_of_nodes: int, optional
+        The number of nodes of the Gaussian rule.
+        Default value = 5
+    -num_threads: int, optional
+        Number of threads used by compute_integral(). The default 0 means itg.get_default_num_threads(); the result
+        does not depend on it.
+    """
+
+
+    def __init__(self, begin, end, subdivision_n, number_of_outputs, integrand, rule='Simpson', number_of_nodes=5, num_threads=0):
+        self.begin=begin
+        self.end=end
+        self.subdivision_n=subdivision_n
+        self.number_of_outputs=number_of_outputs
+        self.integrand=integrand
+        self.rule=rule
+        self.number_of_nodes=number_of_nodes
+        self.num_threads=num_threads
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Complex_Vector_Integration object:
+            This is the C++ backend of the integrator. It is automatically created once an object is instantiated
+            and gets uploaded each time one of the other attributes is modified.
+        """
+
+        backend = itg.Complex_Vector_Integration(self.begin, self.end, self.subdivision_n, self.number_of_outputs, self.integrand, self.rule, self.number_of_nodes)
+        backend.num_threads = self.num_threads
+        return backend
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integrals of the components of the integrand. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - list of complex
+            The integrals of the number_of_outputs components.
+        """
+
+        return self.cpp_backend.compute_integral()
+    
+
+
+    def __repr__(self):
+        return "py_integration.<ComplexVectorIntegration> object. Call 'help' for further details."
+    
+
+
+
+
+
+
+
+# The following function integrates the same function on many intervals, without creating an object for each one
+# of them (the work is done by the C++ functions real_integrate_many and complex_integrate_many).
+
+
+
+def integrate_many(intervals, rule, subdivision_n, integrand, number_of_nodes=5, num_threads=0, complex_valued=False, vectorized=False):
+
+    """
+    Integrate the same function on each one of the given intervals.
+
+    Parameters:
+    - intervals: list of pairs of floats
+        The intervals [a, b] on which we integrate.
+    -rule: string
+        The integration rule: 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).
+    -subdivision_n: int
+        Number of subintervals used on each interval for composite integration.
+    -integrand: function
+        The function we want to integrate.
+    -number_of_nodes: int, optional
+        The number of nodes of the Gaussian rule.
+        Default value = 5
+    -num_threads: int, optional
+        Number of threads among which the intervals are distributed. The default 0 means
+        itg.get_default_num_threads().
+    -complex_valued: bool, optional
+        True if the integrand is complex-valued.
+        Default value = False
+    -vectorized: bool, optional
+        If True, the integrand is called with a NumPy array of nodes and must return the array of its values.
+        Default value = False
+
+    Returns:
+    - list
+        The integrals on the intervals, in the same order.
+    """
+
+    if complex_valued:
+        return itg.complex_integrate_many(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads, vectorized=vectorized)
+    return itg.real_integrate_many(intervals, rule, subdivision_n, integrand, number_of_nodes, num_threads, vectorized=vectorized)
+
+
+
+
+
+
+def multi_integrate(begin, end, subdivision_n, integrand, rule='Gaussian', number_of_nodes=5, grid='Tensor', level=3, num_threads=0, complex_valued=False, vectorized=False):
+
+    """
+    Integrate a function on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]], with D from 1 to 8.
+
+    Parameters:
+    - begin: list of floats
+        The lower extrema of the box.
+    -end: list of floats
+        The upper extrema of the box.
+    -subdivision_n: int
+        Number of subintervals used along each direction.
+    -integrand: function
+        The function we want to integrate. It receives the list of the D coordinates of a point.
+    -rule: string, optional
+        The one-dimensional rule: 'Midpoint', 'Trapezoidal', 'Simpson' or 'Gaussian' (Gauss-Legendre).
+        Default value = 'Gaussian'
+    -number_of_nodes: int, optional
+        The number of nodes of the Gaussian rule (only used by tensor grids).
+        Default value = 5
+    -grid: string, optional
+        'Tensor' (the tensor product of the one-dimensional rule, m^D points) or 'Smolyak' (a sparse grid,
+        far cheaper when D is large).
+        Default value = 'Tensor'
+    -level: int, optional
+        The level of the Smolyak grid.
+        Default value = 3
+    -num_threads: int, optional
+        Number of threads among which the points are distributed. The default 0 means
+        itg.get_default_num_threads().
+    -complex_valued: bool, optional
+        True if the integrand is complex-valued.
+        Default value = False
+    -vectorized: bool, optional
+        If True, the integrand is called with a NumPy array of shape (n, D) containing n points and must return
+        the array of its n values.
+        Default value = False
+
+    Returns:
+    - float or complex
+        The integral.
+    """
+
+    if complex_valued:
+        return itg.complex_multi_integrate(list(begin), list(end), subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized=vectorized)
+    return itg.real_multi_integrate(list(begin), list(end), subdivision_n, integrand, rule, number_of_nodes, grid, level, num_threads, vectorized=vectorized)
+
+
+
+
+
+
+def sampled_integrate(y, x=None, dx=1.0, rule='Trapezoidal', num_threads=0):
+
+    """
+    Integrate sampled data, e.g. measurements, instead of a function. NumPy arrays are passed to C++ through the
+    buffer protocol, so contiguous float64 (or complex128) arrays are not copied.
+
+    Parameters:
+    - y: array_like
+        The samples. If it is complex, the complex integrator is used.
+    -x: array_like, optional
+        The strictly increasing points where the samples were taken, which do not need to be equally spaced. If it
+        is None, the points are equally spaced with distance dx.
+        Default value = None
+    -dx: float, optional
+        The (positive) distance between the points when x is None.
+        Default value = 1.0
+    -rule: string, optional
+        'Trapezoidal', 'Simpson' (on pairs of intervals, with a correction for the last one if their number is
+        odd) or 'Spline' (the integral of the not-a-knot cubic spline, exact for cubic polynomials).
+        Default value = 'Trapezoidal'
+    -num_threads: int, optional
+        Number of threads among which the intervals are distributed. The default 0 means
+        itg.get_default_num_threads().
+
+    Returns:
+    - float or complex
+        The integral on [x[0], x[-1]].
+    """
+
+    if np.iscomplexobj(y):
+        return itg.complex_sampled_integrate(y, x, dx, rule, num_threads)
+    return itg.real_sampled_integrate(y, x, dx, rule, num_threads)
+
+
+
+
+
+
+class MonteCarlo:
+
+    """
+    Class to integrate functions on the box [begin[0], end[0]] x ... x [begin[D-1], end[D-1]] with pseudo-random
+    points, for any dimension D. The random numbers are counter-based, so the result only depends on seed (and not
+    on num_threads).
+
+    Parameters:
+    - begin: list of floats
+        The lower extrema of the box.
+    -end: list of floats
+        The upper extrema of the box.
+    -samples: int
+        The (maximum) number of points of each replicate.
+    -integrand: function
+        The function we want to integrate. It receives the list of the D coordinates of a point.
+    -seed: int, optional
+        The seed of the random numbers.
+        Default value = 0
+    -replicates: int, optional
+        The number of independent estimates. With one replicate the standard error is the one of the sample mean,
+        otherwise it is given by the spread of the replicates.
+        Default value = 1
+    -target_error: float, optional
+        If positive, the points are added in rounds (each one doubling their number) until the standard error is
+        below it. If it is 0, all the points are used and converged is True.
+        Default value = 0
+    -num_threads: int, optional
+        Number of threads used by compute_integral(). The default 0 means itg.get_default_num_threads().
+    -complex_valued: bool, optional
+        True if the integrand is complex-valued.
+        Default value = False
+    -vectorized: bool, optional
+        If True, the integrand is called with a NumPy array of shape (n, D) containing n points and must return
+        the array of its n values.
+        Default value = False
+
+    After compute_integral(), the attributes standard_error, evaluations, converged, running_samples and
+    running_errors describe the computation.
+    """
+
+    backend_name = 'Monte_Carlo'
+    default_replicates = 1
+
+
+    def __init__(self, begin, end, samples, integrand, seed=0, replicates=None, target_error=0, num_threads=0, complex_valued=False, vectorized=False):
+        self.begin=list(begin)
+        self.end=list(end)
+        self.samples=samples
+        self.integrand=integrand
+        self.seed=seed
+        self.replicates=self.default_replicates if replicates is None else replicates
+        self.target_error=target_error
+        self.num_threads=num_threads
+        self.complex_valued=complex_valued
+        self.vectorized=vectorized
+        self.standard_error=None
+        self.evaluations=None
+        self.converged=None
+        self.running_samples=None
+        self.running_errors=None
+
+
+
+    @property
+    def cpp_backend(self):
+
+        """
+        itg.Real_[Quasi_]Monte_Carlo or itg.Complex_[Quasi_]Monte_Carlo object:
+            This is the C++ backend of the integrator. It is automatically created once an object is instantiated
+            and gets uploaded each time one of the other attributes is modified.
+        """
+
+        backend_class = getattr(itg, ('Complex_' if self.complex_valued else 'Real_') + self.backend_name)
+        backend = backend_class(self.begin, self.end, self.samples, self.integrand, self.seed, self.replicates, vectorized=self.vectorized)
+        backend.target_error = self.target_error
+        backend.num_threads = self.num_threads
+        return backend
+
+
+
+    @timer
+    def compute_integral(self):
+
+        """
+        Compute the integral. It is implemented in C++.
+
+        Parameters:
+        - no parameters
+
+        Returns:
+        - float or complex
+            The integral.
+        """
+
+        backend = self.cpp_backend
+        result = backend.compute_integral()
+        self.standard_error = backend.standard_error
+        self.evaluations = backend.evaluations
+        self.converged = backend.converged
+        self.running_samples = backend.running_samples
+        self.running_errors = backend.running_errors
+        return result
+
+
+
+    def __repr__(self):
+        return "py_integration.<" + type(self).__name__ + "> object. Call 'help' for further details."
+
+
+
+
+
+
+class QuasiMonteCarlo(MonteCarlo):
+
+    """
+    Same as MonteCarlo, but the points are the ones of the Halton sequence, shifted randomly (modulo 1) in each
+    replicate: the error decreases much faster for smooth integrands, and the standard error is given by the spread
+    of the replicates (16 by default, at least 2).
+    """
+
+    backend_name = 'Quasi_Monte_Carlo'
+    default_replicates = 16
+
+
+
+
+
+
+def native_function(function, user_data=None):
+
+    """
+    Wrap a compiled function double f(double x, void* user_data) so that it can be used as integrand by every
+    integrator. The integrators then call it directly (as SciPy's LowLevelCallable does) and compute_integral()
+    releases the GIL, so that many Python threads can integrate at the same time.
+
+    Parameters:
+    - function: int, ctypes function pointer or numba cfunc
+        The function (or its address). A numba cfunc must have the signature float64(float64, voidptr); cffi
+        functions can be passed as int(ffi.cast('uintptr_t', f)).
+    -user_data: int or ctypes object, optional
+        The pointer passed to the function at each call (a ctypes object which is not a pointer is passed by
+        address, and must be kept alive while integrating).
+        Default value = None (null pointer)
+
+    Returns:
+    - itg.Native_Function
+        The object to pass as integrand.
+    """
+
+    if hasattr(function, 'address'):        # numba cfunc
+        address = function.address
+    elif isinstance(function, int):
+        address = function
+    else:                                   # ctypes function pointer
+        address = ctypes.cast(function, ctypes.c_void_p).value
+
+    if user_data is None:
+        user_data = 0
+    elif isinstance(user_data, (ctypes._Pointer, ctypes.c_void_p)):
+        user_data = ctypes.cast(user_data, ctypes.c_void_p).value or 0
+    elif not isinstance(user_data, int):    # other ctypes objects (e.g. arrays or structures) are passed by address
+        user_data = ctypes.addressof(user_data)
+
+    return itg.Native_Function(address, user_data)
+
+
+
+
+
 
+# Integrands can also be given as strings, e.g. Expression('x^3*sin(x)'): the string is compiled once in C++ and
+# evaluated there in blocks of nodes, so every integrator can use it without calling Python (and releasing the GIL).
 
+Expression = itg.Expression
 
 
 
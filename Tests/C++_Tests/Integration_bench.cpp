@@ -0,0 +1,150 @@
+#include "../../C++_Code/Includes/Integration/Functions.hpp"
+#include "../../C++_Code/Includes/Integration/Numerical_Integration.hpp"
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <boost/math/quadrature/gauss.hpp> // https://www.boost.org/doc/libs/1_83_0/libs/math/doc/html/math_toolkit/gauss.html
+#include <benchmark/benchmark.h> // https://github.com/google/benchmark
+
+
+/* In this file we measure the speed of the integrators with Google Benchmark, in order to catch regressions in
+the loops of the rules. Each benchmark integrates one of the functions of Functions.hpp on [0, 1] with one rule,
+one field (real or complex) and one value of subdivision_n, and reports:
+- time_per_eval: the time per evaluation of the integrand (printed with its unit, e.g. 20.5ns);
+- evals_per_sec: the number of evaluations of the integrand per second;
+- evaluations: the number of evaluations needed by one call to compute_integral();
+- error: the absolute error of the result.
+The composite Gauss-Legendre rule with 5 nodes is also compared with the one built on Boost's
+boost::math::quadrature::gauss (integrating on each subinterval separately).
+
+The usual options of Google Benchmark can be used, e.g.
+  ./Integration_Bench --benchmark_filter=Simpson --benchmark_format=json
+  ./Integration_Bench --benchmark_out=results.json --benchmark_out_format=json
+to select the benchmarks and to save the results as JSON. */
+
+
+
+namespace {
+
+  constexpr double a = 0;
+  constexpr double b = 1;
+  constexpr unsigned int gauss_nodes = 5;
+
+
+  template <typename field>
+  struct Test_Integrand {
+    std::string name;
+    field (*function)(const double);
+    double exact; // The integral on [0, 1]
+  };
+
+
+  template <typename field>
+  std::vector<Test_Integrand<field>> test_integrands() {
+    return {
+      {"square", ssquare<field>, 1.0/3},
+      {"x_4", forthhh<field>, 1.0/5},
+      {"sine", sinnus<field>, 1-std::cos(1.0)},
+      {"exp_times_sine", exp_times_sinnus<field>, (std::exp(1.0)*(std::sin(1.0)-std::cos(1.0))+1)/2}
+    };
+  }
+
+
+  template <typename field>
+  std::unique_ptr<Integration<field>> make_integrator(const std::string &rule, const unsigned int &subdivision_n, std::function<field(double)> integrand) {
+    if (rule == "Midpoint") {return std::make_unique<Midpoint<field>>(a, b, subdivision_n, integrand);}
+    if (rule == "Trapezoidal") {return std::make_unique<Trapezoidal<field>>(a, b, subdivision_n, integrand);}
+    if (rule == "Simpson") {return std::make_unique<Simpson<field>>(a, b, subdivision_n, integrand);}
+    if (rule == "Gaussian") {return std::make_unique<Gaussian<field>>(a, b, subdivision_n, integrand, gauss_nodes);}
+    throw std::runtime_error("Unknown rule "+rule+".");
+  }
+
+
+  // The number of evaluations is counted once, outside of the timed loop, so that counting does not slow it down.
+
+  void set_counters(benchmark::State &state, const std::size_t &evaluations, const double &error) {
+    state.counters["evaluations"] = static_cast<double>(evaluations);
+    state.counters["evals_per_sec"] = benchmark::Counter(static_cast<double>(evaluations), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["time_per_eval"] = benchmark::Counter(static_cast<double>(evaluations), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["error"] = error;
+  }
+
+
+  template <typename field>
+  void bench_rule(benchmark::State &state, const std::string &rule, const Test_Integrand<field> &integrand) {
+
+    const unsigned int subdivision_n = static_cast<unsigned int>(state.range(0));
+
+    std::size_t evaluations = 0;
+    make_integrator<field>(rule, subdivision_n, [&evaluations, &integrand](double x){++evaluations; return integrand.function(x);})->compute_integral();
+
+    std::unique_ptr<Integration<field>> integrator = make_integrator<field>(rule, subdivision_n, integrand.function);
+    field result{};
+
+    for (auto _ : state) {
+      result = integrator->compute_integral();
+      benchmark::DoNotOptimize(result);
+    }
+
+    set_counters(state, evaluations, std::abs(result-field(integrand.exact)));
+  }
+
+
+  void bench_boost_gauss(benchmark::State &state, const Test_Integrand<double> &integrand) {
+
+    const unsigned int subdivision_n = static_cast<unsigned int>(state.range(0));
+    const double h = (b-a)/subdivision_n;
+
+    auto composite_gauss = [&](auto f) {
+      double sum = 0;
+      for (unsigned int i = 0; i < subdivision_n; ++i) {sum += boost::math::quadrature::gauss<double, gauss_nodes>::integrate(f, a+i*h, a+(i+1)*h);}
+      return sum;
+    };
+
+    std::size_t evaluations = 0;
+    composite_gauss([&evaluations, &integrand](double x){++evaluations; return integrand.function(x);});
+
+    double result = 0;
+
+    for (auto _ : state) {
+      result = composite_gauss(integrand.function);
+      benchmark::DoNotOptimize(result);
+    }
+
+    set_counters(state, evaluations, std::abs(result-integrand.exact));
+  }
+
+
+  template <typename field>
+  void register_rules(const std::string &field_name) {
+    for (const std::string rule : {"Midpoint", "Trapezoidal", "Simpson", "Gaussian"}) {
+      for (const Test_Integrand<field> &integrand : test_integrands<field>()) {
+        benchmark::RegisterBenchmark((field_name+"_"+rule+"/"+integrand.name).c_str(), bench_rule<field>, rule, integrand)
+          ->ArgName("subdivision_n")->RangeMultiplier(100)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+      }
+    }
+  }
+
+}
+
+
+
+int main(int argc, char** argv) {
+
+  register_rules<double>("Real");
+  register_rules<std::complex<double>>("Complex");
+
+  for (const Test_Integrand<double> &integrand : test_integrands<double>()) {
+    benchmark::RegisterBenchmark(("Boost_Gaussian/"+integrand.name).c_str(), bench_boost_gauss, integrand)
+      ->ArgName("subdivision_n")->RangeMultiplier(100)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {return 1;}
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -1,5 +1,9 @@
 #include "../../C++_Code/Includes/Integration/Functions.hpp"
 #include "../../C++_Code/Includes/Integration/Numerical_Integration.hpp"
+#include "../../C++_Code/Includes/Integration/Multi_Integration.hpp"
+#include "../../C++_Code/Includes/Integration/Monte_Carlo.hpp"
+#include "../../C++_Code/Includes/Integration/Sampled_Integration.hpp"
+#include "../../C++_Code/Includes/Integration/Expression.hpp"
 #include <complex>
 #include <iomanip> // For std::fixed, see comments below in the tests regarding order of convergence.
 #include <boost/math/quadrature/gauss.hpp> // https://www.boost.org/doc/libs/1_83_0/libs/math/doc/html/math_toolkit/gauss.html
@@ -577,6 +581,266 @@ int main() {
   
   
 
+  std::cout << "\n--------------------------------------------------------------\n" << std::endl;
+
+
+  /* The integrators also accept batch integrands, i.e. functions evaluating the integrand in many points at once.
+  Here we integrate again e^x*sin(x) on [0, pi/2] (whose integral is (e^(pi/2)+1)/2), counting the number of calls
+  to the integrand. */
+
+
+  unsigned int number_of_calls = 0;
+  Batch_Integrand<double> batch_exp_sin = [&number_of_calls](const double* x, std::size_t n, double* out){
+    ++number_of_calls;
+    for (std::size_t i = 0; i < n; ++i) {out[i] = std::exp(x[i])*std::sin(x[i]);}
+  };
+
+  Simpson<double> Batch_Simpson{a, pi_halves, 10000, batch_exp_sin};
+  Simpson<double> Scalar_Simpson{a, pi_halves, 10000, exp_times_sine<double>};
+
+  std::cout << color << kernel_name << end_color <<"Now we use a batch integrand, which receives many points at once." << std::endl;
+  std::cout << color << kernel_name << end_color <<"The integral of e^x*sin(x) on [0, pi/2] computed by the composite Simpson rule with a batch integrand is " << Batch_Simpson.compute_integral();
+  std::cout << " (it should be " << (std::exp(pi_halves)+1)/2 << "), and it was computed calling the integrand " << number_of_calls << " times (once for each block of points)";
+  std::cout << " instead of " << 2*10000+1 << " times (once for each point, since the points shared by two subintervals are evaluated only once)." << std::endl;
+  std::cout << color << kernel_name << end_color <<"The difference with respect to the usual integrand is " << std::abs(Batch_Simpson.compute_integral()-Scalar_Simpson.compute_integral()) << "." << std::endl;
+
+
+  /* C++ users can also skip the function wrappers altogether, creating the integrators of Integration_Kernels.hpp
+  directly from a lambda, which the compiler is then able to inline. */
+
+
+  auto Inline_Simpson_integrator = make_simpson(a, pi_halves, 10000, [](double x){return std::exp(x)*std::sin(x);});
+
+  std::cout << color << kernel_name << end_color <<"The same integral computed by the Simpson rule created by make_simpson with a lambda as integrand is " << Inline_Simpson_integrator.compute_integral() << "." << std::endl;
+
+
+
+  /* Finally, the composite rules can run in parallel by setting num_threads. We check that the result is exactly
+  the same (not just up to rounding errors) using 1 and 4 threads, and we compare the times. */
+
+
+  constexpr unsigned int subintervals5 = 10000000;
+
+  Simpson<double> Serial_Simpson{a, pi_halves, subintervals5, exp_times_sine<double>};
+  Simpson<double> Parallel_Simpson{a, pi_halves, subintervals5, exp_times_sine<double>};
+  Serial_Simpson.num_threads = 1;
+  Parallel_Simpson.num_threads = 4;
+
+  auto start_serial = std::chrono::high_resolution_clock::now();
+  double serial_result = Serial_Simpson.compute_integral();
+  auto end_serial = std::chrono::high_resolution_clock::now();
+
+  auto start_parallel = std::chrono::high_resolution_clock::now();
+  double parallel_result = Parallel_Simpson.compute_integral();
+  auto end_parallel = std::chrono::high_resolution_clock::now();
+
+  std::cout << color << kernel_name << end_color <<"With " << subintervals5 << " subintervals, the Simpson rule took " << std::chrono::duration_cast<std::chrono::milliseconds>(end_serial-start_serial).count() << " ms with 1 thread and ";
+  std::cout << std::chrono::duration_cast<std::chrono::milliseconds>(end_parallel-start_parallel).count() << " ms with 4 threads." << std::endl;
+  std::cout << color << kernel_name << end_color <<"The two results are " << (serial_result == parallel_result ? "bitwise identical" : "different") << "." << std::endl;
+
+
+
+  /* The adaptive integrator puts the points where they are needed. We integrate 1/(10^-4+(x-0.3)^2), which has a
+  sharp peak in 0.3, on [0, 1]: its integral is 100*(arctan(70)+arctan(30)). */
+
+
+  std::function<double(double)> peak = [](double x){return 1/(1e-4+(x-0.3)*(x-0.3));};
+  const double exact_peak = 100*(std::atan(70.0)+std::atan(30.0));
+
+  Adaptive<double> Adaptive_Peak{a, b, 1, peak, 1e-10};
+  Simpson<double> Simpson_Peak{a, b, 20000, peak};
+
+  double adaptive_peak = Adaptive_Peak.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"The adaptive Gauss-Kronrod integrator computes the integral of a peaked function with error " << std::abs(adaptive_peak-exact_peak) << " (estimated " << Adaptive_Peak.error_estimate << ") using " << Adaptive_Peak.evaluations << " evaluations," << std::endl;
+  std::cout << color << kernel_name << end_color <<"while the Simpson rule needs " << 2*20000+1 << " evaluations to get the error " << std::abs(Simpson_Peak.compute_integral()-exact_peak) << "." << std::endl;
+
+
+
+  // Romberg integration reuses all the points of the previous levels.
+
+
+  Romberg<double> Romberg_Exp_Sin{a, pi_halves, 1, exp_times_sine<double>, 1e-12};
+  double romberg_result = Romberg_Exp_Sin.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"Romberg integration computes the integral of e^x*sin(x) on [0, pi/2] with error " << std::abs(romberg_result-(std::exp(pi_halves)+1)/2) << " using " << Romberg_Exp_Sin.levels << " levels and " << Romberg_Exp_Sin.evaluations << " evaluations." << std::endl;
+
+
+
+  // The same integrand can be integrated on many intervals at once, e.g. on 1000 bins covering [0, pi/2].
+
+
+  std::vector<std::pair<double, double>> bins;
+  for (unsigned int i = 0; i < 1000; ++i) {bins.push_back({i*pi_halves/1000, (i+1)*pi_halves/1000});}
+
+  std::vector<double> bin_integrals = integrate_many<double>(bins, "Gaussian", 1, exp_times_sine<double>, 5);
+
+  std::cout << color << kernel_name << end_color <<"The sum of the integrals of e^x*sin(x) on 1000 bins covering [0, pi/2] computed by integrate_many is " << std::accumulate(bin_integrals.begin(), bin_integrals.end(), 0.0) << "." << std::endl;
+
+
+
+  /* Vector-valued integrands compute many functions at once. Here we compute the first four moments of e^x on
+  [0, 1] evaluating the exponential only once in each node, first with Vector_Integration (the number of outputs
+  is a runtime parameter) and then with make_simpson (the number of outputs is fixed, since the integrand returns
+  a std::array). */
+
+
+  Vector_Integration<double> Moments{a, b, 1000, 4, [](double x, double* out){
+    const double e = std::exp(x);
+    for (unsigned int k = 0; k < 4; ++k) {out[k] = e*std::pow(x, k);}
+  }};
+
+  std::vector<double> moments = Moments.compute_integral();
+
+  auto Fixed_Moments = make_simpson(a, b, 1000, [](double x){
+    const double e = std::exp(x);
+    return std::array<double, 4>{e, e*x, e*x*x, e*x*x*x};
+  });
+
+  std::array<double, 4> fixed_moments = Fixed_Moments.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"The integrals of x^k*e^x on [0, 1] for k = 0, 1, 2, 3 are " << moments[0] << ", " << moments[1] << ", " << moments[2] << ", " << moments[3];
+  std::cout << " (they should be " << std::exp(1.0)-1 << ", 1, " << std::exp(1.0)-2 << ", " << 6-2*std::exp(1.0) << "), and using std::array we get " << fixed_moments[0] << ", " << fixed_moments[1] << ", " << fixed_moments[2] << ", " << fixed_moments[3] << "." << std::endl;
+
+
+
+  /* Native functions (the ones passed from Python through ctypes, cffi or Numba) receive a pointer to their
+  parameters. Here the parameter is the frequency of a sine. */
+
+
+  double frequency = 2;
+  Native_Function Native_Sine{[](double x, void* user_data){return std::sin(*static_cast<double*>(user_data)*x);}, &frequency};
+
+  Simpson<double> Simpson_Native{a, pi_halves, 100, Native_Sine};
+
+  std::cout << color << kernel_name << end_color <<"The integral of sin(2x) on [0, pi/2] computed through a native function is " << Simpson_Native.compute_integral() << " (it should be 1)." << std::endl;
+
+
+
+  /* Convergence studies fit the order over many levels at once (the levels are computed in parallel), instead of
+  comparing two of them. */
+
+
+  Convergence_Study<double> Simpson_Study = convergence_study<double>("Simpson", exp_times_sine<double>, (std::exp(pi_halves)+1)/2, {1, 2, 4, 8, 16, 32, 64}, a, pi_halves);
+
+  std::cout << color << kernel_name << end_color <<"The Simpson rule has polynomial order " << polynomial_order("Simpson") << " and, fitting the errors of " << Simpson_Study.levels_used << " levels, convergence order " << Simpson_Study.convergence_order << "." << std::endl;
+
+
+
+  /* Multidimensional integration: the integral of exp(x_1 + ... + x_D) on [0, 1]^D is (e-1)^D. In three
+  dimensions the tensor grid is cheap, in eight dimensions only the sparse grid is. */
+
+
+  Multi_Integration<double, 3> Tensor_3D{{0, 0, 0}, {1, 1, 1}, 4, [](const std::array<double, 3> &x){return std::exp(x[0]+x[1]+x[2]);}};
+  const double tensor_result = Tensor_3D.compute_integral();
+
+  std::array<double, 8> lower{}, upper;
+  upper.fill(1.0);
+  Multi_Integration<double, 8> Smolyak_8D{lower, upper, 1, [](const std::array<double, 8> &x){
+    double sum = 0;
+    for (double x_k : x) {sum += x_k;}
+    return std::exp(sum);
+  }, "Gaussian", 5, "Smolyak", 4};
+  const double smolyak_result = Smolyak_8D.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"The integral of exp(x+y+z) on [0, 1]^3 with a tensor grid of " << Tensor_3D.evaluations << " points is " << tensor_result << " (it should be " << std::pow(std::exp(1.0)-1, 3) << ")";
+  std::cout << " and the one of exp(x_1+...+x_8) on [0, 1]^8 with a sparse grid of " << Smolyak_8D.evaluations << " points is " << smolyak_result << " (it should be " << std::pow(std::exp(1.0)-1, 8) << ")." << std::endl;
+
+
+
+  /* In 20 dimensions even sparse grids are expensive: the integral of the product of 1+(x_k-1/2)/2 on [0, 1]^20
+  (which is 1) is computed with Monte Carlo and quasi-Monte Carlo, using the same number of evaluations. */
+
+
+  std::vector<double> lower_20(20, 0.0), upper_20(20, 1.0);
+  auto product = [](const double* x){
+    double value = 1;
+    for (unsigned int k = 0; k < 20; ++k) {value *= 1 + (x[k] - 0.5)/2;}
+    return value;
+  };
+
+  Monte_Carlo<double> MC_20D{lower_20, upper_20, 1 << 18, product};
+  Quasi_Monte_Carlo<double> QMC_20D{lower_20, upper_20, 1 << 14, product};
+  const double mc_result = MC_20D.compute_integral();
+  const double qmc_result = QMC_20D.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"With " << MC_20D.evaluations << " evaluations, Monte Carlo gives " << mc_result << " with standard error " << MC_20D.standard_error;
+  std::cout << " and quasi-Monte Carlo gives " << qmc_result << " with standard error " << QMC_20D.standard_error << " (it should be 1)." << std::endl;
+
+
+
+  /* Clenshaw-Curtis rules are nested, so increasing their level only costs the evaluations in the new nodes. */
+
+
+  Clenshaw_Curtis<double> CC{a, pi_halves, 1, exp_times_sine<double>, 1e-14};
+  const double cc_result = CC.compute_integral();
+
+  std::cout << color << kernel_name << end_color <<"The Clenshaw-Curtis rule of level " << CC.level << " gives an error of " << std::abs(cc_result - (std::exp(pi_halves)+1)/2) << " with " << CC.evaluations << " evaluations in total." << std::endl;
+
+
+
+  /* The integrand cheb_ssquare contains the factor sqrt(x*(1-x)), whose derivatives are singular at the endpoints,
+  so the composite rules converge slowly; the tanh-sinh rule does not care. Its integral on [0, 1] is 15*pi/128. */
+
+
+  Double_Exponential<double> DE{0, 1, 1, cheb_ssquare<double>, 1e-14};
+  const double de_result = DE.compute_integral();
+  Simpson<double> Simpson_Singular{0, 1, 1000000, cheb_ssquare<double>};
+
+  std::cout << color << kernel_name << end_color <<"The integral of 3x^2*sqrt(x(1-x)) on [0, 1] has error " << std::abs(de_result - 15*pi_halves/64) << " with the tanh-sinh rule (" << DE.evaluations << " evaluations)";
+  std::cout << " and " << std::abs(Simpson_Singular.compute_integral() - 15*pi_halves/64) << " with the Simpson rule (" << 2*1000000+1 << " evaluations)." << std::endl;
+
+
+
+  /* compute_with_error() returns the same value as compute_integral() together with an estimate of the error,
+  obtained from the same evaluations. */
+
+
+  Simpson<double> Simpson_Estimated{a, pi_halves, 64, exp_times_sine<double>};
+  const Integration_Result<double> estimated = Simpson_Estimated.compute_with_error();
+
+  std::cout << color << kernel_name << end_color <<"The Simpson rule with 64 subintervals has estimated error " << estimated.error_estimate << " and actual error " << std::abs(estimated.value - (std::exp(pi_halves)+1)/2) << " (" << estimated.evaluations << " evaluations)." << std::endl;
+
+
+
+  /* compute_cumulative() gives the integral on [a, x_i] for every point of the partition with the evaluations of a
+  single integral: here the cumulative distribution function of the standard normal distribution on [-5, 5]. */
+
+
+  Simpson<double> Normal_CDF{-5, 5, 1000, [](double x){return std::exp(-x*x/2)/std::sqrt(4*pi_halves);}};
+  const std::vector<double> cdf = Normal_CDF.compute_cumulative();
+
+  std::cout << color << kernel_name << end_color <<"The cumulative Simpson rule gives P(X <= 0) = " << cdf[500] << " and P(X <= 1.96) = " << cdf[696] << " for a standard normal X (they should be 0.5 and about 0.975)." << std::endl;
+
+
+
+  /* Sampled data: the values of x^3 in 21 points which are not equally spaced (x_i = (i/20)^2). The cubic spline
+  is exact, while the trapezoidal and Simpson rules are not. */
+
+
+  std::vector<double> sample_points(21), samples(21);
+  for (std::size_t i = 0; i < 21; ++i) {
+    sample_points[i] = (i/20.0)*(i/20.0);
+    samples[i] = cube<double>(sample_points[i]);
+  }
+
+  std::cout << color << kernel_name << end_color <<"The integral of the samples of x^3 on [0, 1] (it should be 0.25) is " << Sampled_Integration<double>(sample_points.data(), samples.data(), 21, "Trapezoidal").compute_integral() << " with the trapezoidal rule, ";
+  std::cout << Sampled_Integration<double>(sample_points.data(), samples.data(), 21, "Simpson").compute_integral() << " with the Simpson rule and " << Sampled_Integration<double>(sample_points.data(), samples.data(), 21, "Spline").compute_integral() << " with the cubic spline." << std::endl;
+
+
+
+  /* Integrands can also be given as strings, compiled by Expression into a bytecode which is evaluated in blocks of
+  nodes (this is meant for the Python bindings, where it avoids calling Python in each node). */
+
+
+  const Expression expression("x^3*sin(x)");
+  Gaussian<double> Expression_Gaussian{a, b, 10, Batch_Integrand<double>(expression), 5};
+
+  std::cout << color << kernel_name << end_color <<"The expression '" << expression.source << "' was compiled into " << expression.program.size() << " instructions; its integral on [0, 1] is " << Expression_Gaussian.compute_integral();
+  std::cout << " (it should be " << 5*std::cos(1.0) - 3*std::sin(1.0) << ")." << std::endl;
+
+
+
   result +=1; // Just to avoid the warning 'unused variable'.
   number_of_nodes2 += 1; // Same here.
 
@@ -12,6 +12,7 @@ import integration as itg # the module 'integration' compiled using C++ was save
 from math import *
 from scipy.integrate import quad
 import time
+import ctypes
 
 
 
@@ -204,6 +205,143 @@ def main():
 
 
 
+    # Vectorized integrands: the integrand receives a NumPy array of nodes and returns the array of its values.
+    print('Now we will check that vectorized integrands give the same results as the scalar ones.')
+
+
+
+    PRS_vectorized = pitg.RealSimpson(0, 1, 1000, lambda x: np.sin(x)*x**4 - 4*x + np.log(x+1), vectorized = True)
+    PRS_scalar = pitg.RealSimpson(0, 1, 1000, some_ugly_function)
+
+    assert(abs(PRS_vectorized.compute_integral() - PRS_scalar.compute_integral()) < 1e-13)
+
+    PCG_vectorized = pitg.ComplexGaussian(-1, 8, 3, lambda x: np.exp(1j*x), number_of_nodes = n_nodes, vectorized = True)
+    PCG_scalar = pitg.ComplexGaussian(-1, 8, 3, lambda x: np.exp(1j*x), number_of_nodes = n_nodes)
+
+    assert(abs(PCG_vectorized.compute_integral() - PCG_scalar.compute_integral()) < 1e-13)
+
+    many = pitg.integrate_many([(0, 1), (1, 2), (2, 3)], 'Gaussian', 4, lambda x: x**2, vectorized = True)
+
+    assert(np.allclose(many, [1/3, 7/3, 19/3], rtol = 0, atol = 1e-13))
+
+    print("\n-----------------------------\n")
+
+
+
+    # Native integrands: a compiled function double f(double x, void* user_data), here a ctypes callback.
+    print('Now we will integrate a function given as a C function pointer.')
+
+
+
+    native_prototype = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_double, ctypes.c_void_p)
+    native_square = native_prototype(lambda x, user_data: x*x)
+    native_scaled = native_prototype(lambda x, user_data: ctypes.cast(user_data, ctypes.POINTER(ctypes.c_double))[0]*x)
+    scale = ctypes.c_double(3.0)
+
+    PRG_native = pitg.RealGaussian(-1, 1, 4, pitg.native_function(native_square), number_of_nodes = n_nodes)
+
+    assert(abs(PRG_native.compute_integral() - 2/3) < 1e-14)
+
+    PCM_native = pitg.ComplexMidpoint(0, 1, 1, pitg.native_function(native_scaled, scale))
+
+    assert(abs(PCM_native.compute_integral() - 1.5) < 1e-14)
+
+    print("\n-----------------------------\n")
+
+
+
+    # Asynchronous integration: compute_integral_async() returns a future while the integral is computed in C++.
+    print('Now we will run some integrations in the background.')
+
+
+
+    futures = [pitg.RealSimpson(0, k, 1000, cos).compute_integral_async() for k in range(1, 5)]
+    complex_future = PCG.compute_integral_async()
+
+    for k, future in enumerate(futures, start = 1):
+        assert(abs(future.result() - sin(k)) < 1e-10)
+        assert(future.done())
+
+    assert(abs(complex_future.result() - PCG.compute_integral()) < 1e-14)
+
+    print("\n-----------------------------\n")
+
+
+
+    # Cumulative integrals: the integrals on [begin, x_i] for all the points of the partition in a single sweep.
+    print('Now we will compute some cumulative integrals.')
+
+
+
+    PRS_cumulative = pitg.RealSimpson(0, 2, 100, cos)
+    cumulative = PRS_cumulative.compute_cumulative()
+
+    assert(len(cumulative) == 101 and cumulative[0] == 0)
+    assert(abs(cumulative[-1] - PRS_cumulative.compute_integral()) < 1e-14)
+    assert(np.allclose(cumulative, np.sin(PRS_cumulative.partition), rtol = 0, atol = 1e-9))
+
+    complex_cumulative = pitg.ComplexGaussian(0, 1, 10, lambda x: 1j*x**2, number_of_nodes = n_nodes).compute_cumulative()
+
+    assert(np.allclose(complex_cumulative, 1j*np.linspace(0, 1, 11)**3/3, rtol = 0, atol = 1e-14))
+
+    try:
+        pitg.RealAdaptive(0, 1, 1, cos).compute_cumulative()
+        assert(False)
+    except NotImplementedError:
+        pass
+
+    print("\n-----------------------------\n")
+
+
+
+    # Sampled data: the integral of the values y taken in the points x (NumPy arrays are read without copies).
+    print('Now we will integrate some sampled data.')
+
+
+
+    x_samples = np.sort(np.random.default_rng(0).uniform(0, 1, 200))
+    x_samples[0], x_samples[-1] = 0, 1
+
+    assert(abs(pitg.sampled_integrate(x_samples**3, x_samples, rule = 'Spline') - 1/4) < 1e-12)
+    assert(abs(pitg.sampled_integrate(x_samples**2, x_samples, rule = 'Simpson') - 1/3) < 1e-12)
+    assert(abs(pitg.sampled_integrate(x_samples, x_samples, rule = 'Trapezoidal') - 1/2) < 1e-12)
+    assert(abs(pitg.sampled_integrate(np.exp(1j*np.linspace(0, 1, 101)), dx = 0.01, rule = 'Simpson') - (np.exp(1j) - 1)/1j) < 1e-8)
+
+    try:
+        pitg.sampled_integrate(np.ones(3), np.array([0.0, 1.0, 1.0]))
+        assert(False)
+    except RuntimeError:
+        pass
+
+    print("\n-----------------------------\n")
+
+
+
+    # Expression integrands: the string is compiled once and evaluated in C++, without calling Python.
+    print('Now we will integrate some functions given as strings.')
+
+
+
+    expression = pitg.Expression('x^3*sin(x)')
+    python_function = lambda x: x**3*sin(x)
+
+    assert(abs(expression.evaluate(2.0) - python_function(2.0)) < 1e-14)
+    assert(np.allclose(expression.evaluate(np.linspace(0, 1, 5)), [python_function(x) for x in np.linspace(0, 1, 5)], rtol = 1e-15, atol = 0))
+
+    assert(abs(pitg.RealGaussian(0, 1, 10, expression, number_of_nodes = 5).compute_integral() - pitg.RealGaussian(0, 1, 10, python_function, number_of_nodes = 5).compute_integral()) < 1e-14)
+    assert(abs(pitg.RealSimpson(0, 1, 100, expression, num_threads = 2).compute_integral() - pitg.RealSimpson(0, 1, 100, python_function).compute_integral()) < 1e-14)
+    assert(abs(pitg.ComplexAdaptive(0, 1, 1, pitg.Expression('exp(-x**2)')).compute_integral() - quad(lambda x: exp(-x**2), 0, 1)[0]) < 1e-10)
+
+    try:
+        pitg.Expression('x^3*sin(x')
+        assert(False)
+    except RuntimeError:
+        pass
+
+    print("\n-----------------------------\n")
+
+
+
     # BENCHMARKING:
 
 